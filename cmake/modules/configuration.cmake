@@ -48,6 +48,11 @@ find_package(Eigen3 3.3 REQUIRED)
 
 message(STATUS "Eigen3 include_dir=${EIGEN3_INCLUDE_DIR} version=${EIGEN3_VERSION_STRING}")
 
+if (DAREFL_USE_HDF5)
+    find_package(HDF5 REQUIRED COMPONENTS C)
+    message(STATUS "HDF5 include_dirs=${HDF5_INCLUDE_DIRS} version=${HDF5_VERSION}")
+endif()
+
 get_target_property(Qt5Widgets_location Qt5::Widgets LOCATION_Release)
 message(STATUS " Qt5 libraries : ${Qt5Widgets_LIBRARIES} ${Qt5Widgets_location}")
 message(STATUS " Qt5 Includes  : ${Qt5Widgets_INCLUDE_DIRS}")
@@ -15,11 +15,15 @@
 #include <darefl/famousloader/importtextview.h>
 #include <darefl/famousloader/importutils.h>
 
+#include <QCoreApplication>
 #include <QDialogButtonBox>
 #include <QHBoxLayout>
 #include <QLabel>
+#include <QMessageBox>
+#include <QProgressDialog>
 #include <QSizePolicy>
 #include <QSplitter>
+#include <QStandardPaths>
 #include <QString>
 #include <QVBoxLayout>
 
@@ -32,6 +36,10 @@ DataLoaderDialog::DataLoaderDialog(QWidget* parent) : QDialog(parent)
     // Init the main import logic
     p_data_import_logic =
         std::unique_ptr<DataImportLogic::ImportLogic>(new DataImportLogic::ImportLogic());
+    p_preview = std::make_unique<DataImportLogic::ImportPreview>(p_data_import_logic.get());
+    p_data_import_logic->setCacheDirectory(
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation).toStdString()
+        + "/importcache");
 
     // The placeholders
     auto h_splitter = new QSplitter(this);
@@ -89,11 +97,32 @@ void DataLoaderDialog::setTargets(std::vector<std::pair<std::string, std::string
     p_target_select->setCurrentText(QString::fromStdString(current_target));
 }
 
-//! Build and set out the final result
+//! Build and set out the final result, the files are processed in parallel under a progress
+//! dialog which allows to cancel the import
 DataImportLogic::ImportOutput DataLoaderDialog::result()
 {
-    auto result = p_data_import_logic->getFinalOutput();
+    QProgressDialog progress("Importing files ...", "Cancel", 0, p_data_import_logic->fileCount(),
+                             this);
+    progress.setWindowModality(Qt::WindowModal);
+    progress.setMinimumDuration(500);
+
+    auto on_progress = [&progress](int processed_files) {
+        progress.setValue(processed_files);
+        QCoreApplication::processEvents();
+        return progress.wasCanceled();
+    };
+    auto result = p_data_import_logic->getFinalOutput(on_progress);
     result.setTarget(p_target_select->currentData().value<QString>().toStdString());
+
+    const auto unreadable_files = p_data_import_logic->unreadableFiles();
+    if (!unreadable_files.empty()) {
+        QStringList paths;
+        for (const auto& path : unreadable_files)
+            paths << QString::fromStdString(path);
+        QMessageBox::warning(this, "Data import",
+                             "The following files could not be read and were skipped:\n"
+                                 + paths.join("\n"));
+    }
     return result;
 }
 
@@ -116,7 +145,12 @@ void DataLoaderDialog::setUpFileListSpace(QGroupBox* conainer)
 
     connect(p_import_file_list, &ImportFileWidget::filesChanged,
             [this](const std::vector<std::string>& files) {
+                const bool was_empty = p_data_import_logic->fileCount() == 0;
+                p_preview->setFile(-1);
                 p_data_import_logic.get()->setFiles(files);
+                // the filters are only proposed for the first files, not to undo user changes
+                if (was_empty && !files.empty())
+                    p_parameter_dialog->detectFormat(0);
             });
 
     connect(p_import_file_list, SIGNAL(selectionChanged()), this, SLOT(selectedFileChanged()));
@@ -142,6 +176,7 @@ void DataLoaderDialog::setUpSelectionSpace(QTabWidget* tab_widget)
     auto first_tab = new QWidget(tab_widget);
     auto first_layout = new QVBoxLayout(first_tab);
     p_text_view = new ImportTextView(first_tab);
+    p_text_view->setPreview(p_preview.get());
     first_layout->addWidget(p_text_view);
 
     auto second_tab = new QWidget(tab_widget);
@@ -161,11 +196,13 @@ void DataLoaderDialog::selectedFileChanged()
 {
     int file_num = p_import_file_list->currentSelection();
     if (file_num < 0) {
-        p_text_view->setHtml("");
+        p_preview->setFile(-1);
+        p_text_view->refreshPreview();
         p_table_view->model()->refreshFromDataStructure();
     } else {
         if (p_selection_space->currentIndex() == 0) {
-            p_text_view->setHtml(QString::fromStdString(p_data_import_logic->getPreview(file_num)));
+            p_preview->setFile(file_num);
+            p_text_view->refreshPreview();
         } else if (p_selection_space->currentIndex() == 1) {
             p_data_import_logic->updateData(file_num);
             p_table_view->model()->refreshFromDataStructure();
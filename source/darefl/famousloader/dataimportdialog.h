@@ -16,6 +16,7 @@
 #include <QSettings>
 #include <QTabWidget>
 #include <darefl/famousloader/importlogic.h>
+#include <darefl/famousloader/importpreview.h>
 
 #include <memory>
 #include <string>
@@ -72,6 +73,7 @@ private:
     ImportTextView* p_text_view{nullptr};
     ImportTableView* p_table_view{nullptr};
     std::unique_ptr<DataImportLogic::ImportLogic> p_data_import_logic;
+    std::unique_ptr<DataImportLogic::ImportPreview> p_preview;
     QTabWidget* p_selection_space{nullptr};
     QComboBox* p_target_select{nullptr};
 };
@@ -0,0 +1,289 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include <darefl/famousloader/importcache.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+//! Identifies the entries, the last character is the version of the layout
+const char magic[8] = {'D', 'R', 'F', 'L', 'C', 'C', 'H', '1'};
+
+bool isLittleEndian()
+{
+    const uint16_t probe = 1;
+    return *reinterpret_cast<const unsigned char*>(&probe) == 1;
+}
+
+//! Key of an entry, the source file has to be unchanged and parsed with the same filters
+struct EntryKey {
+    uint64_t size{0};
+    int64_t modified{0};
+    std::string text; //! source path and filter signature
+};
+
+bool makeKey(const std::string& source_path, const std::string& signature, EntryKey& key)
+{
+    QFileInfo info(QString::fromStdString(source_path));
+    if (!info.exists())
+        return false;
+    key.size = static_cast<uint64_t>(info.size());
+    key.modified = info.lastModified().toMSecsSinceEpoch();
+    key.text = source_path + '\n' + signature;
+    return true;
+}
+
+//! Serializes the entry into 8-byte words
+class Writer
+{
+public:
+    void word(uint64_t value)
+    {
+        for (int i = 0; i < 8; ++i)
+            m_buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+
+    void text(const std::string& value)
+    {
+        word(value.size());
+        m_buffer += value;
+        m_buffer.append((8 - value.size() % 8) % 8, '\0');
+    }
+
+    void values(const std::vector<double>& values)
+    {
+        word(values.size());
+        if (isLittleEndian()) {
+            const auto offset = m_buffer.size();
+            m_buffer.resize(offset + values.size() * sizeof(double));
+            std::memcpy(&m_buffer[offset], values.data(), values.size() * sizeof(double));
+        } else {
+            for (double value : values) {
+                uint64_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                word(bits);
+            }
+        }
+    }
+
+    std::string m_buffer;
+};
+
+//! Reads the 8-byte words of an entry, every read fails once the end was passed
+class Reader
+{
+public:
+    Reader(const char* data, size_t size) : m_data(data), m_size(size) {}
+
+    bool word(uint64_t& value)
+    {
+        if (m_offset + 8 > m_size)
+            return false;
+        value = 0;
+        for (int i = 0; i < 8; ++i)
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(m_data[m_offset + i]))
+                     << (8 * i);
+        m_offset += 8;
+        return true;
+    }
+
+    bool text(std::string& value)
+    {
+        uint64_t size;
+        if (!word(size) || size > m_size - m_offset)
+            return false;
+        value.assign(m_data + m_offset, size);
+        m_offset += size + (8 - size % 8) % 8;
+        return m_offset <= m_size;
+    }
+
+    bool values(std::vector<double>& values)
+    {
+        uint64_t size;
+        if (!word(size) || size > (m_size - m_offset) / sizeof(double))
+            return false;
+        values.resize(size);
+        if (isLittleEndian()) {
+            std::memcpy(values.data(), m_data + m_offset, size * sizeof(double));
+            m_offset += size * sizeof(double);
+        } else {
+            for (auto& value : values) {
+                uint64_t bits;
+                word(bits);
+                std::memcpy(&value, &bits, sizeof(value));
+            }
+        }
+        return true;
+    }
+
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_offset{0};
+};
+
+} // namespace
+
+namespace DataImportLogic
+{
+
+//! The constructor, the directory is created when the first entry is stored
+ImportCache::ImportCache(std::string directory, int64_t max_size)
+    : m_directory(std::move(directory)), m_max_size(max_size)
+{
+}
+
+//! Getter for the cache directory
+const std::string& ImportCache::directory() const
+{
+    return m_directory;
+}
+
+//! Getter for the limit of the total size of the entries in bytes
+int64_t ImportCache::maxSize() const
+{
+    return m_max_size;
+}
+
+//! Return the path of the entry for the given source file
+std::string ImportCache::entryPath(const std::string& source_path) const
+{
+    std::stringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0')
+         << std::hash<std::string>{}(source_path) << ".bin";
+    return m_directory + "/" + name.str();
+}
+
+//! Load the header and the columns of the source file, return false if there is no valid entry
+//! for the file in its current state parsed with the given filter signature
+bool ImportCache::load(const std::string& source_path, const std::string& signature,
+                       DataImportUtils::header_map& header,
+                       DataImportUtils::numeric_data& data) const
+{
+    EntryKey key;
+    if (!makeKey(source_path, signature, key))
+        return false;
+
+    QFile file(QString::fromStdString(entryPath(source_path)));
+    if (!file.open(QIODevice::ReadOnly) || file.size() < static_cast<qint64>(sizeof(magic)))
+        return false;
+    auto address = file.map(0, file.size());
+    if (!address)
+        return false;
+
+    const auto content = reinterpret_cast<const char*>(address);
+    if (std::memcmp(content, magic, sizeof(magic)) != 0)
+        return false;
+    Reader reader(content + sizeof(magic), file.size() - sizeof(magic));
+
+    uint64_t size, modified;
+    std::string text;
+    if (!reader.word(size) || !reader.word(modified) || !reader.text(text))
+        return false;
+    if (size != key.size || static_cast<int64_t>(modified) != key.modified || text != key.text)
+        return false;
+
+    uint64_t header_count;
+    if (!reader.word(header_count))
+        return false;
+    DataImportUtils::header_map header_entries;
+    for (uint64_t i = 0; i < header_count; ++i) {
+        uint64_t column;
+        std::string name;
+        if (!reader.word(column) || !reader.text(name))
+            return false;
+        header_entries.emplace(name, static_cast<int>(column));
+    }
+
+    uint64_t column_count;
+    if (!reader.word(column_count))
+        return false;
+    DataImportUtils::numeric_data columns;
+    for (uint64_t i = 0; i < column_count; ++i) {
+        std::vector<double> values;
+        if (!reader.values(values))
+            return false;
+        columns.push_back(std::move(values));
+    }
+
+    // the modification time of the entry orders the entries for the eviction
+    file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+
+    header = std::move(header_entries);
+    data = std::move(columns);
+    return true;
+}
+
+//! Store the header and the columns parsed from the source file. The entry is written to a
+//! temporary file first and replaces a previous one atomically, concurrent readers never see a
+//! partial entry.
+bool ImportCache::store(const std::string& source_path, const std::string& signature,
+                        const DataImportUtils::header_map& header,
+                        const DataImportUtils::numeric_data& data) const
+{
+    EntryKey key;
+    if (!makeKey(source_path, signature, key))
+        return false;
+
+    Writer writer;
+    writer.m_buffer.assign(magic, sizeof(magic));
+    writer.word(key.size);
+    writer.word(static_cast<uint64_t>(key.modified));
+    writer.text(key.text);
+    writer.word(header.size());
+    for (const auto& [name, column] : header) {
+        writer.word(static_cast<uint64_t>(column));
+        writer.text(name);
+    }
+    writer.word(data.size());
+    for (const auto& column : data)
+        writer.values(column);
+
+    if (!QDir().mkpath(QString::fromStdString(m_directory)))
+        return false;
+    const auto entry_path = entryPath(source_path);
+    QSaveFile file(QString::fromStdString(entry_path));
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    file.write(writer.m_buffer.data(), writer.m_buffer.size());
+    if (!file.commit())
+        return false;
+
+    evict(entry_path);
+    return true;
+}
+
+//! Remove the least recently used entries which don't fit into the size limit. The given entry
+//! is kept, even if it exceeds the limit alone.
+void ImportCache::evict(const std::string& kept_path) const
+{
+    const auto kept_name = QFileInfo(QString::fromStdString(kept_path)).fileName();
+    const auto entries = QDir(QString::fromStdString(m_directory))
+                             .entryInfoList({"*.bin"}, QDir::Files, QDir::Time);
+
+    // entries are sorted from the most recently used one
+    int64_t total_size = 0;
+    for (const auto& entry : entries) {
+        total_size += entry.size();
+        if (total_size > m_max_size && entry.fileName() != kept_name)
+            QFile::remove(entry.absoluteFilePath());
+    }
+}
+
+} // namespace DataImportLogic
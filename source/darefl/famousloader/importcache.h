@@ -0,0 +1,55 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#ifndef DAREFL_FAMOUSLOADER_IMPORTCACHE_H
+#define DAREFL_FAMOUSLOADER_IMPORTCACHE_H
+
+#include <darefl/famousloader/importutils.h>
+
+#include <cstdint>
+#include <string>
+
+namespace DataImportLogic
+{
+
+//! On-disk cache of the parsed content of imported files, so that unchanged files aren't parsed
+//! again. An entry is keyed by the path, size and modification time of the source file and by the
+//! signature of the line filters it was parsed with.
+//!
+//! Entries are binary files: a metadata block followed by the columns as little-endian float64
+//! values. Every field is 8-byte aligned, so the columns can be used directly from a memory mapped
+//! entry.
+//!
+//! The total size of the entries is limited: storing an entry removes the least recently used
+//! ones beyond the limit. Loading an entry marks it as used.
+class ImportCache
+{
+public:
+    ImportCache(std::string directory, int64_t max_size = 256 * 1024 * 1024);
+
+    const std::string& directory() const;
+    int64_t maxSize() const;
+    std::string entryPath(const std::string& source_path) const;
+
+    bool load(const std::string& source_path, const std::string& signature,
+              DataImportUtils::header_map& header, DataImportUtils::numeric_data& data) const;
+    bool store(const std::string& source_path, const std::string& signature,
+               const DataImportUtils::header_map& header,
+               const DataImportUtils::numeric_data& data) const;
+
+private:
+    void evict(const std::string& kept_path) const;
+
+    std::string m_directory;
+    int64_t m_max_size;
+};
+
+} // namespace DataImportLogic
+
+#endif // DAREFL_FAMOUSLOADER_IMPORTCACHE_H
@@ -31,15 +31,9 @@ DataColumn::DataColumn(const std::string& header)
 void DataColumn::setValues(const std::vector<std::string>& values)
 {
     clearValues();
-    for (const auto& value : values) {
-        double value_double;
-        try {
-            value_double = std::stod(value);
-        } catch (std::exception& e) {
-            value_double = std::nan("");
-        }
-        m_values.push_back(value_double);
-    }
+    m_values.reserve(values.size());
+    for (const auto& value : values)
+        m_values.push_back(DataImportUtils::toDouble(value));
 }
 
 //! Setter for the values (doubles)
@@ -48,6 +42,12 @@ void DataColumn::setValues(const std::vector<double>& values)
     m_values = values;
 }
 
+//! Setter for the values (doubles), takes over the buffer
+void DataColumn::setValues(std::vector<double>&& values)
+{
+    m_values = std::move(values);
+}
+
 //! Clear the values int the column
 void DataColumn::clearValues()
 {
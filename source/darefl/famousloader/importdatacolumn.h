@@ -29,6 +29,7 @@ public:
 
     void setValues(const std::vector<std::string>& values);
     void setValues(const std::vector<double>& values);
+    void setValues(std::vector<double>&& values);
     void clearValues();
     int rowCount();
 
@@ -17,6 +17,22 @@ namespace DataImportLogic
 //! This is the constructor of DataStructure
 DataStructure::DataStructure() {}
 
+//! Copy of the columns and their settings without the values
+std::unique_ptr<DataStructure> DataStructure::emptyCopy() const
+{
+    auto output = std::make_unique<DataStructure>();
+    output->m_history = m_history;
+    for (const auto& column : m_data_columns) {
+        auto new_column = std::make_unique<DataColumn>(column->header());
+        new_column->setName(column->name());
+        new_column->setType(column->type());
+        new_column->setUnit(column->unit());
+        new_column->setMultiplier(column->multiplier());
+        output->m_data_columns.push_back(std::move(new_column));
+    }
+    return output;
+}
+
 //! This is the set data routine used if not header data is provided
 void DataStructure::setData(DataImportUtils::string_data& data)
 {
@@ -47,6 +63,35 @@ void DataStructure::setData(DataImportUtils::header_map& headers,
     }
 }
 
+//! This is the set data routine for converted columns if not header data is provided
+void DataStructure::setData(DataImportUtils::numeric_data&& data)
+{
+    clearColumnValues();
+    processHeaders(data.size());
+
+    for (int i = 0; i < data.size(); ++i) {
+        m_data_columns.at(i)->setValues(std::move(data.at(i)));
+    }
+}
+
+//! This is the set data routine for converted columns if header data is provided
+void DataStructure::setData(DataImportUtils::header_map& headers,
+                            DataImportUtils::numeric_data&& data)
+{
+    std::vector<std::string> keys;
+    for (const auto& header : headers) {
+        keys.push_back(header.first);
+    }
+
+    clearColumnValues();
+    processHeaders(keys);
+
+    for (const auto& header : keys) {
+        if (headers[header] < data.size())
+            column(header)->setValues(std::move(data.at(headers[header])));
+    }
+}
+
 //! Process the headers (add columns if missmatch)
 void DataStructure::processHeaders(int num)
 {
@@ -29,8 +29,12 @@ public:
     DataStructure();
     ~DataStructure() = default;
 
+    std::unique_ptr<DataStructure> emptyCopy() const;
+
     void setData(DataImportUtils::string_data& data);
     void setData(DataImportUtils::header_map& headers, DataImportUtils::string_data& data);
+    void setData(DataImportUtils::numeric_data&& data);
+    void setData(DataImportUtils::header_map& headers, DataImportUtils::numeric_data&& data);
 
     DataColumn* column(const std::string& header);
     const DataColumn* column(int column) const;
@@ -9,30 +9,88 @@
 
 #include <darefl/famousloader/importfile.h>
 
-#include <fstream>
-#include <iostream>
+#include <QFile>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
 
 namespace DataImportLogic
 {
 
 //! The constructor
-ImportFile::ImportFile(std::string path_to_file) : m_filepath(path_to_file)
+ImportFile::ImportFile(std::string path_to_file)
+    : m_filepath(std::move(path_to_file)),
+      p_file(std::make_unique<QFile>(QString::fromStdString(m_filepath)))
 {
     loadFile();
-    generateThumbnail();
 }
 
-//! Generate the thumbnail
+//! The destructor, unmaps and closes the file
+ImportFile::~ImportFile() = default;
+
+//! Map the file into memory
 void ImportFile::loadFile()
 {
-    m_file.clear();
-    std::ifstream file(m_filepath);
-    std::string line;
-    while (getline(file, line)) {
-        m_file.push_back(line);
-        ;
-    };
-    file.close();
+    m_content = std::string_view();
+    if (p_file->open(QIODevice::ReadOnly) && p_file->size() > 0) {
+        if (auto address = p_file->map(0, p_file->size()); address) {
+            m_content = std::string_view(reinterpret_cast<const char*>(address),
+                                         static_cast<size_t>(p_file->size()));
+        } else {
+            m_buffer = p_file->readAll().toStdString();
+            m_content = m_buffer;
+        }
+    }
+}
+
+//! Build the views of all lines in a single pass over the buffer
+void ImportFile::indexLines() const
+{
+    std::call_once(m_lines_indexed, [this]() {
+        const auto newlines = std::count(m_content.begin(), m_content.end(), '\n');
+        m_lines.reserve(static_cast<size_t>(newlines) + 1);
+        readLines(0, m_content.size(), m_lines);
+    });
+}
+
+//! Append views of at most max_lines lines starting at the given offset of the buffer. Line
+//! ends (\n or \r\n) are not part of the lines. Return the offset after the last line read.
+size_t ImportFile::readLines(size_t offset, size_t max_lines,
+                             std::vector<std::string_view>& lines) const
+{
+    const char* begin = m_content.data() + offset;
+    const char* end = m_content.data() + m_content.size();
+
+    for (size_t i = 0; i < max_lines && begin < end; ++i) {
+        auto newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+        std::string_view line(begin, (newline ? newline : end) - begin);
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        lines.push_back(line);
+        begin = newline ? newline + 1 : end;
+    }
+    return begin - m_content.data();
+}
+
+//! Stream the file in chunks of lines. Memory use is bounded by the chunk size, the index of all
+//! lines isn't built. Throws if the chunk size isn't positive.
+void ImportFile::readChunks(int chunk_size, const chunk_callback_t& callback) const
+{
+    if (chunk_size <= 0)
+        throw std::runtime_error("ImportFile: chunk size " + std::to_string(chunk_size)
+                                 + " isn't positive");
+
+    std::vector<std::string_view> lines;
+    lines.reserve(static_cast<size_t>(chunk_size));
+    size_t offset = 0;
+    int first_line = 0;
+    while (offset < m_content.size()) {
+        lines.clear();
+        offset = readLines(offset, static_cast<size_t>(chunk_size), lines);
+        if (!callback(first_line, lines))
+            return;
+        first_line += lines.size();
+    }
 }
 
 //! Retrieve the path
@@ -41,35 +99,72 @@ const std::string& ImportFile::path() const
     return m_filepath;
 }
 
-//! The getter for the thumbnail text
-const std::vector<std::string>& ImportFile::thumbnail() const
+//! The getter for the thumbnail text, the first lines of the file
+std::vector<std::string_view> ImportFile::thumbnail() const
 {
-    return m_thumbnail;
+    std::vector<std::string_view> output;
+    readLines(0, m_thumbnail_length, output);
+    return output;
 }
 
-//! The getter for the thumbnail text
-const std::vector<std::string>& ImportFile::file() const
+//! The getter for all lines of the file
+const std::vector<std::string_view>& ImportFile::file() const
 {
-    return m_file;
+    indexLines();
+    return m_lines;
 }
 
-//! Generate the thumbnail
-void ImportFile::generateThumbnail()
+//! Return a precise line
+std::string_view ImportFile::line(int line_number) const
 {
-    int size = (m_thumbnail_length < m_file.size()) ? (m_thumbnail_length) : (m_file.size());
-    m_thumbnail.clear();
-    m_thumbnail.resize(size);
-    std::ifstream file(m_filepath);
-    for (int i = 0; i < size; ++i) {
-        getline(file, m_thumbnail[i]);
-    };
-    file.close();
+    indexLines();
+    return m_lines.at(line_number);
 }
 
-//! Return a precise line
-const std::string& ImportFile::line(int line_number) const
+//! Return the number of lines
+int ImportFile::lineCount() const
 {
-    return m_file.at(line_number);
+    indexLines();
+    return static_cast<int>(m_lines.size());
+}
+
+//! Return at most max_lines lines, starting with the first complete line after the given
+//! relative position (0 to 1) in the file. The index of all lines isn't built.
+std::vector<std::string_view> ImportFile::sampleLines(double position, int max_lines) const
+{
+    std::vector<std::string_view> output;
+    size_t offset = static_cast<size_t>(std::clamp(position, 0.0, 1.0) * m_content.size());
+    if (offset > 0) {
+        offset = m_content.find('\n', offset - 1);
+        if (offset == std::string_view::npos)
+            return output;
+        ++offset;
+    }
+    readLines(offset, max_lines, output);
+    return output;
+}
+
+//! Return at most max_lines lines from the end of the file, in the order of the file. The index
+//! of all lines isn't built.
+std::vector<std::string_view> ImportFile::lastLines(int max_lines) const
+{
+    size_t end = m_content.size();
+    if (end > 0 && m_content[end - 1] == '\n')
+        --end;
+
+    // the start of the line containing the character before pos
+    auto line_start = [this](size_t pos) -> size_t {
+        auto newline = (pos > 0) ? m_content.rfind('\n', pos - 1) : std::string_view::npos;
+        return (newline == std::string_view::npos) ? 0 : newline + 1;
+    };
+
+    size_t offset = line_start(end);
+    for (int i = 1; i < max_lines && offset > 0; ++i)
+        offset = line_start(offset - 1);
+
+    std::vector<std::string_view> output;
+    readLines(offset, max_lines, output);
+    return output;
 }
 
 } // namespace DataImportLogic
@@ -10,31 +10,56 @@
 #ifndef DAREFL_FAMOUSLOADER_IMPORTFILE_H
 #define DAREFL_FAMOUSLOADER_IMPORTFILE_H
 
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 
+class QFile;
+
 namespace DataImportLogic
 {
 
+//! Gives access to the lines of a text file. The file content is memory mapped, lines are
+//! views into the mapped buffer and stay valid for the lifetime of the object. The index of all
+//! lines is only built when requested, the file can be streamed in chunks of lines without it.
 class ImportFile
 {
 public:
+    //! Receives the number of the first line in the chunk and the lines, returns false to stop
+    using chunk_callback_t =
+        std::function<bool(int first_line, const std::vector<std::string_view>& lines)>;
+
     ImportFile(std::string path_to_file);
-    ~ImportFile() = default;
+    ~ImportFile();
+
+    ImportFile(const ImportFile&) = delete;
+    ImportFile& operator=(const ImportFile&) = delete;
 
     const std::string& path() const;
-    const std::vector<std::string>& thumbnail() const;
-    const std::vector<std::string>& file() const;
-    const std::string& line(int line_number) const;
+    std::vector<std::string_view> thumbnail() const;
+    const std::vector<std::string_view>& file() const;
+    std::string_view line(int line_number) const;
+    int lineCount() const;
+    std::vector<std::string_view> sampleLines(double position, int max_lines) const;
+    std::vector<std::string_view> lastLines(int max_lines) const;
+
+    void readChunks(int chunk_size, const chunk_callback_t& callback) const;
 
 private:
-    void generateThumbnail();
     void loadFile();
+    void indexLines() const;
+    size_t readLines(size_t offset, size_t max_lines, std::vector<std::string_view>& lines) const;
 
 private:
     std::string m_filepath;
-    std::vector<std::string> m_thumbnail;
-    std::vector<std::string> m_file;
+    std::unique_ptr<QFile> p_file;
+    std::string m_buffer; //! file content, if the file can't be mapped
+    std::string_view m_content;
+    mutable std::vector<std::string_view> m_lines;
+    mutable std::once_flag m_lines_indexed;
     int m_thumbnail_length = 40;
 };
 } // namespace DataImportLogic
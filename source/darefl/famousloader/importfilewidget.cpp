@@ -8,6 +8,7 @@
 // ************************************************************************** //
 
 #include <darefl/famousloader/importfilewidget.h>
+#include <darefl/famousloader/importnexusreader.h>
 #include <darefl/mainwindow/styleutils.h>
 
 #include <QFileDialog>
@@ -96,9 +97,12 @@ void ImportFileWidget::writeSettings()
 //! This is the method called by the add file button
 void ImportFileWidget::addFiles()
 {
+    QString filters = "Text (*.txt);; CSV (*.csv)";
+    if (DataImportLogic::NexusReader::isAvailable())
+        filters += ";; NeXus/HDF5 (*.nxs *.h5 *.hdf5)";
     QStringList files = QFileDialog::getOpenFileNames(this, "Select one or more files to load",
-                                                      m_default_path, "Text (*.txt);; CSV (*.csv)",
-                                                      nullptr, QFileDialog::DontUseNativeDialog);
+                                                      m_default_path, filters, nullptr,
+                                                      QFileDialog::DontUseNativeDialog);
     if (files.count() > 0)
         m_default_path = QFileInfo(files[0]).absoluteDir().absolutePath();
 
@@ -202,6 +202,15 @@ void ImportFilterWidget::removeLineFilter()
     // --------------------------------
 }
 
+//! Set up the line filters from the format detected in the file of the given row
+void ImportFilterWidget::detectFormat(int row)
+{
+    if (!p_import_logic->detectFormat(row).valid)
+        return;
+    resetFromLineFilters();
+    emit parameterChanged();
+}
+
 //! Read the settings froma QSetting structure
 void ImportFilterWidget::readSettings()
 {
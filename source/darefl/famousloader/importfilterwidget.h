@@ -41,6 +41,7 @@ public:
 
     void addLineFilter();
     void removeLineFilter();
+    void detectFormat(int row);
 
     void readSettings();
     void writeSettings();
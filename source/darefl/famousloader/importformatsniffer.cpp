@@ -0,0 +1,196 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include <darefl/famousloader/importfile.h>
+#include <darefl/famousloader/importformatsniffer.h>
+#include <darefl/famousloader/importutils.h>
+
+#include <cctype>
+#include <cstdlib>
+#include <map>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+using DataImportLogic::SniffedFormat;
+
+//! Number of lines sampled at the start, the middle and the end of the file
+const int sample_size = 200;
+
+//! Number of lines scanned for the start of the data if it isn't in the first sample
+const int search_chunk_size = 4096;
+
+//! Separator candidates, in the order of preference if several fit equally well
+const std::vector<char> separators = {'\t', ',', ';', '|', ' ', ':'};
+
+std::string_view trimmed(std::string_view text)
+{
+    const auto begin = text.find_first_not_of(" \t");
+    if (begin == std::string_view::npos)
+        return {};
+    return text.substr(begin, text.find_last_not_of(" \t") - begin + 1);
+}
+
+//! Whether the token is a number as a whole, up to surrounding blanks
+bool isNumber(std::string_view token)
+{
+    token = trimmed(token);
+    if (token.empty())
+        return false;
+    const std::string text(token);
+    char* end = nullptr;
+    std::strtod(text.c_str(), &end);
+    return end == text.c_str() + text.size();
+}
+
+//! Number of tokens of the line if all of them are numbers, 0 otherwise
+int numericColumns(std::string_view line, char separator)
+{
+    int count = 0;
+    bool numeric = true;
+    DataImportUtils::forEachToken(line, separator, [&](auto token) {
+        if (trimmed(token).empty())
+            return;
+        numeric = numeric && isNumber(token);
+        ++count;
+    });
+    return numeric ? count : 0;
+}
+
+//! Number of non-blank tokens of the line
+int columns(std::string_view line, char separator)
+{
+    int count = 0;
+    DataImportUtils::forEachToken(line, separator, [&](auto token) {
+        if (!trimmed(token).empty())
+            ++count;
+    });
+    return count;
+}
+
+//! Choose the separator splitting most sampled lines into the same number of numeric columns,
+//! more columns win if several separators fit equally well
+void chooseSeparator(const std::vector<std::string_view>& lines, SniffedFormat& format)
+{
+    int best_score = 0;
+    for (char separator : separators) {
+        std::map<int, int> histogram;
+        for (auto line : lines)
+            if (int count = numericColumns(line, separator); count > 0)
+                ++histogram[count];
+        for (auto [count, frequency] : histogram) {
+            if (frequency > best_score
+                || (frequency == best_score && count > format.column_count)) {
+                best_score = frequency;
+                format.separator = separator;
+                format.column_count = count;
+            }
+        }
+    }
+    format.valid = best_score > 0;
+}
+
+//! The character starting the line, if it can't be part of a number
+std::string commentPrefix(std::string_view line)
+{
+    line = trimmed(line);
+    if (line.empty())
+        return {};
+    const unsigned char first = line.front();
+    if (std::isalnum(first) || first == '-' || first == '+' || first == '.')
+        return {};
+    return std::string(1, line.front());
+}
+
+} // namespace
+
+namespace DataImportLogic
+{
+
+//! Infer the layout of the file from a few hundred lines at its start, middle and end. The
+//! separator and the number of columns are chosen from the numeric lines of all samples; the
+//! data starts with the first line matching them, a header is the line right before the data if
+//! it has as many columns. The total number of lines is only needed, and the index of the lines
+//! only built, if the file ends with lines which are not data.
+SniffedFormat sniffFormat(const ImportFile& file)
+{
+    SniffedFormat format;
+    auto head = file.sampleLines(0.0, sample_size);
+    auto middle = file.sampleLines(0.5, sample_size);
+    auto tail = file.lastLines(sample_size);
+
+    std::vector<std::string_view> samples = head;
+    samples.insert(samples.end(), middle.begin(), middle.end());
+    samples.insert(samples.end(), tail.begin(), tail.end());
+    chooseSeparator(samples, format);
+    if (!format.valid)
+        return format;
+
+    auto is_data = [&format](std::string_view line) {
+        return numericColumns(line, format.separator) == format.column_count;
+    };
+
+    // first data line, the file is scanned further if it isn't in the first sample
+    std::vector<std::string_view> before_data;
+    format.data_start = -1;
+    file.readChunks(search_chunk_size, [&](int first_line, const auto& lines) {
+        for (size_t i = 0; i < lines.size(); ++i) {
+            if (is_data(lines.at(i))) {
+                format.data_start = first_line + static_cast<int>(i);
+                return false;
+            }
+            before_data.push_back(lines.at(i));
+        }
+        return true;
+    });
+    if (format.data_start < 0) {
+        format.valid = false;
+        return format;
+    }
+
+    // header is the last non-blank line before the data, if it names every column
+    for (int i = static_cast<int>(before_data.size()) - 1; i >= 0; --i) {
+        auto line = trimmed(before_data.at(i));
+        if (line.empty())
+            continue;
+        auto prefix = commentPrefix(line);
+        line.remove_prefix(prefix.size());
+        if (columns(line, format.separator) == format.column_count) {
+            format.header_line = i;
+            format.header_prefix = prefix;
+        }
+        break;
+    }
+
+    // the comment prefix shared by all other non-blank lines before the data
+    for (int i = 0; i < static_cast<int>(before_data.size()); ++i) {
+        if (trimmed(before_data.at(i)).empty()
+            || (i == format.header_line && format.header_prefix.empty()))
+            continue;
+        auto prefix = commentPrefix(before_data.at(i));
+        if (format.comment_prefix.empty())
+            format.comment_prefix = prefix;
+        if (prefix.empty() || prefix != format.comment_prefix) {
+            format.comment_prefix.clear();
+            break;
+        }
+    }
+
+    // lines which are not data at the end of the file
+    size_t trailing_lines = 0;
+    for (auto it = tail.rbegin(); it != tail.rend() && !is_data(*it); ++it)
+        ++trailing_lines;
+    if (trailing_lines > 0 && trailing_lines < tail.size())
+        format.data_end = file.lineCount() - static_cast<int>(trailing_lines);
+
+    return format;
+}
+
+} // namespace DataImportLogic
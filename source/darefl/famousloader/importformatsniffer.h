@@ -0,0 +1,36 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#ifndef DAREFL_FAMOUSLOADER_IMPORTFORMATSNIFFER_H
+#define DAREFL_FAMOUSLOADER_IMPORTFORMATSNIFFER_H
+
+#include <string>
+
+namespace DataImportLogic
+{
+
+class ImportFile;
+
+//! The layout of a data file as inferred from samples of its lines
+struct SniffedFormat {
+    bool valid{false};          //! numeric data was found
+    char separator{' '};        //! separator of the data columns
+    int column_count{0};        //! number of numeric columns
+    std::string comment_prefix; //! prefix of the comment lines before the data, if any
+    int header_line{-1};        //! line holding the column names, -1 if there is none
+    std::string header_prefix;  //! comment prefix in front of the column names, if any
+    int data_start{0};          //! first data line
+    int data_end{-1};           //! line after the last data line, -1 for the end of the file
+};
+
+SniffedFormat sniffFormat(const ImportFile& file);
+
+} // namespace DataImportLogic
+
+#endif // DAREFL_FAMOUSLOADER_IMPORTFORMATSNIFFER_H
@@ -0,0 +1,110 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include <darefl/famousloader/importignorematcher.h>
+
+#include <algorithm>
+#include <queue>
+
+namespace
+{
+const int alphabet_size = 256;
+} // namespace
+
+namespace DataImportLogic
+{
+
+//! Build the automaton. The trie of the ignore strings is completed into a full transition
+//! table following the failure links, empty strings are skipped.
+IgnoreMatcher::IgnoreMatcher(const std::vector<std::string>& ignore_strings)
+{
+    addNode();
+    for (const auto& ignore_string : ignore_strings) {
+        if (ignore_string.empty())
+            continue;
+        m_first_bytes[static_cast<unsigned char>(ignore_string.front())] = true;
+        int node = 0;
+        for (unsigned char c : ignore_string) {
+            if (m_transitions[node * alphabet_size + c] == 0)
+                m_transitions[node * alphabet_size + c] = addNode();
+            node = m_transitions[node * alphabet_size + c];
+        }
+        m_match_length[node] = ignore_string.size();
+    }
+
+    // breadth first, so that the failure target of a node is complete before the node
+    std::vector<int> failure(m_match_length.size(), 0);
+    std::queue<int> nodes;
+    for (int c = 0; c < alphabet_size; ++c)
+        if (int child = m_transitions[c]; child != 0)
+            nodes.push(child);
+
+    while (!nodes.empty()) {
+        const int node = nodes.front();
+        nodes.pop();
+        m_match_length[node] = std::max(m_match_length[node], m_match_length[failure[node]]);
+        for (int c = 0; c < alphabet_size; ++c) {
+            int& child = m_transitions[node * alphabet_size + c];
+            const int fallback = m_transitions[failure[node] * alphabet_size + c];
+            if (child == 0) {
+                child = fallback;
+            } else {
+                failure[child] = fallback;
+                nodes.push(child);
+            }
+        }
+    }
+}
+
+//! Whether there is nothing to remove
+bool IgnoreMatcher::empty() const
+{
+    return m_match_length.size() == 1;
+}
+
+//! Return the line without the ignore strings. The characters are appended to the buffer one by
+//! one and an ignore string is dropped as soon as it ends the buffer, the longest one if several
+//! do. Occurrences formed by the removal of another one are removed as well, like with repeated
+//! erasing. The returned view points into the line if nothing had to be removed.
+std::string_view IgnoreMatcher::strip(std::string_view line, Buffer& buffer) const
+{
+    auto first = std::find_if(line.begin(), line.end(), [this](char c) {
+        return m_first_bytes[static_cast<unsigned char>(c)];
+    });
+    if (first == line.end())
+        return line;
+
+    // no ignore string starts before the first candidate, the automaton is in the root there
+    const size_t prefix = first - line.begin();
+    buffer.text.assign(line.substr(0, prefix));
+    buffer.states.assign(prefix + 1, 0);
+
+    int state = 0;
+    for (auto it = first; it != line.end(); ++it) {
+        state = m_transitions[state * alphabet_size + static_cast<unsigned char>(*it)];
+        buffer.text.push_back(*it);
+        buffer.states.push_back(state);
+        if (const int length = m_match_length[state]; length > 0) {
+            buffer.text.resize(buffer.text.size() - length);
+            buffer.states.resize(buffer.states.size() - length);
+            state = buffer.states.back();
+        }
+    }
+    return buffer.text;
+}
+
+//! Append a node without transitions and return its index
+int IgnoreMatcher::addNode()
+{
+    m_transitions.resize(m_transitions.size() + alphabet_size, 0);
+    m_match_length.push_back(0);
+    return m_match_length.size() - 1;
+}
+
+} // namespace DataImportLogic
@@ -0,0 +1,49 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#ifndef DAREFL_FAMOUSLOADER_IMPORTIGNOREMATCHER_H
+#define DAREFL_FAMOUSLOADER_IMPORTIGNOREMATCHER_H
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DataImportLogic
+{
+
+//! Removes all the ignore strings of a line filter from a line in a single pass. The strings are
+//! compiled once into an Aho-Corasick automaton; lines without any possible match are returned
+//! without being copied.
+class IgnoreMatcher
+{
+public:
+    //! Reusable storage for the stripped line and the automaton states along it
+    struct Buffer {
+        std::string text;
+        std::vector<int> states;
+    };
+
+    IgnoreMatcher(const std::vector<std::string>& ignore_strings = {});
+
+    bool empty() const;
+    std::string_view strip(std::string_view line, Buffer& buffer) const;
+
+private:
+    int addNode();
+
+private:
+    std::vector<int> m_transitions; //! 256 transitions per node, node 0 is the root
+    std::vector<int> m_match_length; //! longest ignore string ending at the node, 0 if none
+    std::array<bool, 256> m_first_bytes{};
+};
+
+} // namespace DataImportLogic
+
+#endif // DAREFL_FAMOUSLOADER_IMPORTIGNOREMATCHER_H
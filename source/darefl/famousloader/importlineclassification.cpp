@@ -0,0 +1,120 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include <darefl/famousloader/importlineclassification.h>
+#include <darefl/famousloader/importlinefilter.h>
+
+#include <algorithm>
+
+namespace DataImportLogic
+{
+
+//! Convert the type string of a line filter, unknown types are treated as comments
+LineType lineType(const std::string& type_string)
+{
+    if (type_string == "Header")
+        return LineType::Header;
+    if (type_string == "Units")
+        return LineType::Units;
+    if (type_string == "Data")
+        return LineType::Data;
+    if (type_string == "Info")
+        return LineType::Info;
+    return LineType::Comments;
+}
+
+//! Compile the filters, applied in the given order so that later filters take precedence. The
+//! lines are split at every start and end line of the active filters, each resulting range is
+//! classified once.
+LineClassification::LineClassification(const std::vector<LineFilter*>& line_filters)
+{
+    ignoreSetId({});
+    colorId("black");
+
+    std::vector<int> boundaries = {0};
+    for (const auto line_filter : line_filters) {
+        if (!line_filter->active())
+            continue;
+        boundaries.push_back(std::max(line_filter->start(), 0));
+        if (line_filter->end() != -1)
+            boundaries.push_back(std::max(line_filter->end(), 0));
+    }
+    std::sort(boundaries.begin(), boundaries.end());
+    boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+    for (const auto first_line : boundaries) {
+        Entry entry;
+        for (const auto line_filter : line_filters) {
+            if (!line_filter->active() || first_line < line_filter->start())
+                continue;
+            if (line_filter->end() != -1 && first_line >= line_filter->end())
+                continue;
+            entry.type = lineType(line_filter->type());
+            entry.separator = line_filter->separatorChar();
+            entry.ignore_set = ignoreSetId(line_filter->ignoreStrings());
+            entry.color = colorId(line_filter->color());
+        }
+        m_first_lines.push_back(first_line);
+        m_entries.push_back(entry);
+    }
+}
+
+//! Getter for the classification of the given line
+const LineClassification::Entry& LineClassification::entry(int line) const
+{
+    auto it = std::upper_bound(m_first_lines.begin(), m_first_lines.end(), line);
+    return m_entries.at(std::max(int(it - m_first_lines.begin()) - 1, 0));
+}
+
+//! Getter for the ignore strings of the given id
+const std::vector<std::string>& LineClassification::ignoreSet(int id) const
+{
+    return m_ignore_sets.at(id);
+}
+
+//! Getter for the compiled matcher of the ignore strings of the given id
+const IgnoreMatcher& LineClassification::ignoreMatcher(int id) const
+{
+    return m_ignore_matchers.at(id);
+}
+
+//! Getter for the color of the given id
+const std::string& LineClassification::color(int id) const
+{
+    return m_colors.at(id);
+}
+
+//! Getter for the number of line ranges in the table
+int LineClassification::segmentCount() const
+{
+    return m_entries.size();
+}
+
+//! Return the id of the ignore strings, storing them if they are new
+int LineClassification::ignoreSetId(const std::vector<std::string>& ignore_strings)
+{
+    auto it = std::find(m_ignore_sets.begin(), m_ignore_sets.end(), ignore_strings);
+    if (it != m_ignore_sets.end())
+        return it - m_ignore_sets.begin();
+    m_ignore_sets.push_back(ignore_strings);
+    m_ignore_matchers.emplace_back(ignore_strings);
+    return m_ignore_sets.size() - 1;
+}
+
+//! Return the id of the color, storing it if it is new
+int LineClassification::colorId(const std::string& color)
+{
+    auto it = std::find(m_colors.begin(), m_colors.end(), color);
+    if (it != m_colors.end())
+        return it - m_colors.begin();
+    m_colors.push_back(color);
+    return m_colors.size() - 1;
+}
+
+} // namespace DataImportLogic
@@ -0,0 +1,64 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#ifndef DAREFL_FAMOUSLOADER_IMPORTLINECLASSIFICATION_H
+#define DAREFL_FAMOUSLOADER_IMPORTLINECLASSIFICATION_H
+
+#include <darefl/famousloader/importignorematcher.h>
+
+#include <string>
+#include <vector>
+
+namespace DataImportLogic
+{
+
+class LineFilter;
+
+//! The type of a line as set by the line filters
+enum class LineType { Comments, Header, Units, Data, Info };
+
+LineType lineType(const std::string& type_string);
+
+//! The line filter chain compiled into a classification table. Every filter covers a contiguous
+//! range of lines, so the table holds one entry per range of lines sharing the same
+//! classification rather than one entry per line, and doesn't depend on the file size.
+class LineClassification
+{
+public:
+    //! Classification of a line, ignore strings and colors are stored once and referenced by id
+    struct Entry {
+        LineType type{LineType::Comments};
+        char separator{'!'};
+        int ignore_set{0};
+        int color{0};
+    };
+
+    LineClassification(const std::vector<LineFilter*>& line_filters);
+
+    const Entry& entry(int line) const;
+    const std::vector<std::string>& ignoreSet(int id) const;
+    const IgnoreMatcher& ignoreMatcher(int id) const;
+    const std::string& color(int id) const;
+    int segmentCount() const;
+
+private:
+    int ignoreSetId(const std::vector<std::string>& ignore_strings);
+    int colorId(const std::string& color);
+
+private:
+    std::vector<int> m_first_lines;
+    std::vector<Entry> m_entries;
+    std::vector<std::vector<std::string>> m_ignore_sets;
+    std::vector<IgnoreMatcher> m_ignore_matchers;
+    std::vector<std::string> m_colors;
+};
+
+} // namespace DataImportLogic
+
+#endif // DAREFL_FAMOUSLOADER_IMPORTLINECLASSIFICATION_H
@@ -10,8 +10,16 @@
 #include <darefl/famousloader/importlinefilter.h>
 #include <darefl/famousloader/importutils.h>
 
+#include <algorithm>
+#include <atomic>
 #include <sstream>
 
+namespace
+{
+//! Source of the revisions, shared by all filters so that a revision identifies a filter state
+std::atomic<size_t> last_revision{0};
+} // namespace
+
 namespace DataImportLogic
 {
 
@@ -20,6 +28,7 @@ LineFilter::LineFilter(std::string name)
     : m_name(name), m_active(false), m_start_line(0), m_end_line(1), m_separator(' '),
       m_type_string("Data"), m_color("black")
 {
+    touch();
 }
 
 //! Return only the keys of the separators
@@ -36,16 +45,8 @@ std::vector<std::string> LineFilter::separatorNames() const
 //! Set the right colors in the vector
 void LineFilter::processColors(std::vector<std::string>& color_vec) const
 {
-    if (!m_active)
-        return;
-
-    int start = m_start_line;
-    int end = (m_end_line == -1) ? (color_vec.size()) : (m_end_line);
-
-    if (start > color_vec.size())
-        return;
-
-    for (int i = start; i < ((end < color_vec.size()) ? (end) : (color_vec.size())); ++i) {
+    auto [begin, end] = range(color_vec.size());
+    for (int i = begin; i < end; ++i) {
         color_vec.at(i) = m_color;
     }
 }
@@ -53,16 +54,8 @@ void LineFilter::processColors(std::vector<std::string>& color_vec) const
 //! Set the right separator in the vector
 void LineFilter::processSeparator(std::vector<char>& separator_vec) const
 {
-    if (!m_active)
-        return;
-
-    int start = m_start_line;
-    int end = (m_end_line == -1) ? (separator_vec.size()) : (m_end_line);
-
-    if (start > separator_vec.size())
-        return;
-
-    for (int i = start; i < ((end < separator_vec.size()) ? (end) : (separator_vec.size())); ++i) {
+    auto [begin, end] = range(separator_vec.size());
+    for (int i = begin; i < end; ++i) {
         separator_vec.at(i) = m_separator;
     }
 }
@@ -70,16 +63,8 @@ void LineFilter::processSeparator(std::vector<char>& separator_vec) const
 //! Set the right type to the vector
 void LineFilter::processType(std::vector<std::string>& type_vec) const
 {
-    if (!m_active)
-        return;
-
-    int start = m_start_line;
-    int end = (m_end_line == -1) ? (type_vec.size()) : (m_end_line);
-
-    if (start > type_vec.size())
-        return;
-
-    for (int i = start; i < ((end < type_vec.size()) ? (end) : (type_vec.size())); ++i) {
+    auto [begin, end] = range(type_vec.size());
+    for (int i = begin; i < end; ++i) {
         type_vec.at(i) = m_type_string;
     }
 }
@@ -87,20 +72,24 @@ void LineFilter::processType(std::vector<std::string>& type_vec) const
 //! Set the right type to the vector
 void LineFilter::processIgnore(std::vector<std::vector<std::string>>& ignore_vec) const
 {
-    if (!m_active)
-        return;
-
-    int start = m_start_line;
-    int end = (m_end_line == -1) ? (ignore_vec.size()) : (m_end_line);
-
-    if (start > ignore_vec.size())
-        return;
-
-    for (int i = start; i < ((end < ignore_vec.size()) ? (end) : (ignore_vec.size())); ++i) {
+    auto [begin, end] = range(ignore_vec.size());
+    for (int i = begin; i < end; ++i) {
         ignore_vec.at(i) = m_ignore_strings;
     }
 }
 
+//! The range of vector indices covered by the filter, for a vector of the given size holding
+//! all lines of the file. An end line of -1 means up to the end of the file.
+std::pair<int, int> LineFilter::range(int size) const
+{
+    if (!m_active)
+        return {0, 0};
+
+    int begin = std::max(m_start_line, 0);
+    int end = (m_end_line == -1) ? (size) : (std::min(m_end_line, size));
+    return {begin, std::max(begin, end)};
+}
+
 //! Getter for the name
 std::string LineFilter::name() const
 {
@@ -125,6 +114,12 @@ std::string LineFilter::separator() const
     return m_separator_str;
 }
 
+//! Getter for the separator character
+char LineFilter::separatorChar() const
+{
+    return m_separator;
+}
+
 //! Getter for the color string
 std::string LineFilter::color() const
 {
@@ -159,6 +154,12 @@ int LineFilter::end() const
     return m_end_line;
 }
 
+//! Getter for the revision, changes whenever a setter modifies the filter
+size_t LineFilter::revision() const
+{
+    return m_revision;
+}
+
 //! Build the separator string
 void LineFilter::setSeparators(std::map<std::string, char>* separators)
 {
@@ -175,12 +176,14 @@ void LineFilter::setName(std::string name)
 void LineFilter::setActive(bool active)
 {
     m_active = active;
+    touch();
 }
 
 //! Set the type
 void LineFilter::setType(std::string type_string)
 {
     m_type_string = type_string;
+    touch();
 }
 
 //! Set the separator
@@ -188,18 +191,21 @@ void LineFilter::setSeparator(std::string separator_name)
 {
     m_separator_str = separator_name;
     m_separator = m_separators->at(separator_name);
+    touch();
 }
 
 //! Set the color
 void LineFilter::setColor(std::string color_string)
 {
     m_color = color_string;
+    touch();
 }
 
 //! Set the ignore strings from a vector of strings
 void LineFilter::setIgnoreStrings(std::vector<std::string>& ignore_strings)
 {
     m_ignore_strings = ignore_strings;
+    touch();
 }
 
 //! Set the ignore strings from a single string
@@ -219,12 +225,20 @@ void LineFilter::setIgnoreString(std::string ignore_string)
 void LineFilter::setStart(int start_line)
 {
     m_start_line = start_line;
+    touch();
 }
 
 //! Set the end line
 void LineFilter::setEnd(int end_line)
 {
     m_end_line = end_line;
+    touch();
+}
+
+//! Give the filter a new revision
+void LineFilter::touch()
+{
+    m_revision = ++last_revision;
 }
 
 } // namespace DataImportLogic
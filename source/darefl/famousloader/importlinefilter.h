@@ -40,11 +40,13 @@ public:
     bool active() const;
     std::string type() const;
     std::string separator() const;
+    char separatorChar() const;
     std::string color() const;
     std::vector<std::string> ignoreStrings() const;
     std::string ignoreString() const;
     int start() const;
     int end() const;
+    size_t revision() const;
 
     //! Setters
     void setName(std::string);
@@ -57,6 +59,10 @@ public:
     void setStart(int start_line);
     void setEnd(int end_line);
 
+private:
+    std::pair<int, int> range(int size) const;
+    void touch();
+
 private:
     std::string m_name;
     std::string m_separator_str;
@@ -71,6 +77,7 @@ private:
 
     int m_start_line;
     int m_end_line;
+    size_t m_revision{0};
 
     std::map<std::string, char>* m_separators{nullptr};
 };
@@ -9,7 +9,21 @@
 
 #include <darefl/famousloader/importdatacolumn.h>
 #include <darefl/famousloader/importlogic.h>
+#include <darefl/famousloader/importnexusreader.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
 #include <iterator>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+//! Number of lines processed at once when streaming files
+const int chunk_size = 65536;
+} // namespace
 
 namespace DataImportLogic
 {
@@ -64,6 +78,23 @@ std::vector<LineFilter*> ImportLogic::lineFilterOrder() const
     return output;
 }
 
+//! Return the line filters compiled into the classification of the lines. The table is shared
+//! by preview, header and data extraction and only compiled again when a filter was changed,
+//! added, removed or reordered.
+std::shared_ptr<const LineClassification> ImportLogic::lineClassification() const
+{
+    std::vector<std::pair<const LineFilter*, size_t>> key;
+    for (const auto& filter_ptr : m_line_filters)
+        key.emplace_back(filter_ptr.get(), filter_ptr->revision());
+
+    std::lock_guard<std::mutex> lock(m_classification_mutex);
+    if (!p_classification || key != m_classification_key) {
+        p_classification = std::make_shared<const LineClassification>(lineFilterOrder());
+        m_classification_key = std::move(key);
+    }
+    return p_classification;
+}
+
 //! This is the slot for adding files into the local memory
 void ImportLogic::setFiles(const std::vector<std::string>& file_paths)
 {
@@ -74,52 +105,170 @@ void ImportLogic::setFiles(const std::vector<std::string>& file_paths)
     }
 }
 
-//! Process all files and then send the output
-ImportOutput ImportLogic::getFinalOutput()
+//! Return the number of files
+int ImportLogic::fileCount() const
+{
+    return m_files.size();
+}
+
+//! Keep the parsed files in a cache in the given directory, an empty string disables the cache
+void ImportLogic::setCacheDirectory(const std::string& directory)
+{
+    p_cache = directory.empty() ? nullptr : std::make_unique<ImportCache>(directory);
+}
+
+//! Getter for the file of the given row
+const ImportFile* ImportLogic::importFile(const int& row) const
+{
+    return m_files.at(row).get();
+}
+
+//! Infer the format of the given file from samples of its lines and set up the header and the
+//! data filter accordingly. The filters are left untouched if no numeric data is found.
+SniffedFormat ImportLogic::detectFormat(const int& row)
+{
+    auto format = sniffFormat(*m_files.at(row));
+    if (!format.valid)
+        return format;
+
+    auto separator = std::find_if(m_separators.begin(), m_separators.end(),
+                                  [&](const auto& pair) { return pair.second == format.separator; });
+
+    auto header_filter = typeInFilters("Header");
+    if (!header_filter) {
+        header_filter = addLineFilter("Header");
+        header_filter->setType("Header");
+    }
+    header_filter->setActive(format.header_line >= 0);
+    header_filter->setSeparator(separator->first);
+    if (format.header_line >= 0) {
+        header_filter->setStart(format.header_line);
+        header_filter->setEnd(format.header_line + 1);
+        header_filter->setIgnoreString(format.header_prefix);
+    }
+
+    auto data_filter = typeInFilters("Data");
+    if (!data_filter) {
+        data_filter = addLineFilter("Data");
+        data_filter->setType("Data");
+    }
+    data_filter->setActive(true);
+    data_filter->setSeparator(separator->first);
+    data_filter->setStart(format.data_start);
+    data_filter->setEnd(format.data_end);
+    data_filter->setIgnoreString("");
+
+    return format;
+}
+
+//! Process all files in parallel and then send the output. Every file is parsed into its own
+//! copy of the current column layout. The callback is called from the calling thread whenever
+//! files got processed, an empty output is returned if it requests cancellation. Files which
+//! couldn't be read are left out of the output and reported by unreadableFiles().
+ImportOutput ImportLogic::getFinalOutput(const progress_callback_t& callback)
 {
+    const int file_count = m_files.size();
+    const auto layout = p_data_structure->emptyCopy();
+    lineClassification(); // compiled once here, shared by all workers
+    std::vector<std::unique_ptr<DataStructure>> data_structures(file_count);
+    std::vector<char> readable(file_count, 0);
+
+    std::atomic<int> next_file{0};
+    std::atomic<bool> cancelled{false};
+    std::mutex mutex;
+    std::condition_variable condition;
+    int processed_files = 0;
+    int running_workers = 0;
+    std::exception_ptr error;
+
+    auto worker = [&]() {
+        try {
+            for (int i = next_file++; i < file_count && !cancelled; i = next_file++) {
+                auto data_structure = layout->emptyCopy();
+                readable[i] = fillDataStructure(i, *data_structure);
+                data_structures[i] = std::move(data_structure);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ++processed_files;
+                }
+                condition.notify_one();
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error)
+                error = std::current_exception();
+            cancelled = true;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        --running_workers;
+        condition.notify_one();
+    };
+
+    const int worker_count =
+        std::min(file_count, std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+    running_workers = worker_count;
+    std::vector<std::thread> workers;
+    for (int i = 0; i < worker_count; ++i)
+        workers.emplace_back(worker);
+
+    // report the progress from the calling thread until all workers are done, the last report
+    // is made after they finished so that it is never missed
+    std::unique_lock<std::mutex> lock(mutex);
+    int reported_files = 0;
+    while (true) {
+        const bool finished = running_workers == 0;
+        if (callback && processed_files != reported_files) {
+            reported_files = processed_files;
+            lock.unlock();
+            if (callback(reported_files))
+                cancelled = true;
+            lock.lock();
+        }
+        if (finished)
+            break;
+        condition.wait_for(lock, std::chrono::milliseconds(50));
+    }
+    lock.unlock();
+
+    for (auto& thread : workers)
+        thread.join();
+
+    if (error)
+        std::rethrow_exception(error);
+
     ImportOutput output;
-    for (int i = 0; i < m_files.size(); ++i) {
-        updateData(i);
-        output.freezData(m_files.at(i)->path(), *(p_data_structure.get()));
+    m_unreadable_files.clear();
+    if (cancelled)
+        return output;
+
+    for (int i = 0; i < file_count; ++i) {
+        if (readable.at(i))
+            output.freezData(m_files.at(i)->path(), *data_structures.at(i));
+        else
+            m_unreadable_files.push_back(m_files.at(i)->path());
     }
     return output;
 }
 
+//! Getter for the paths of the files which couldn't be read by the last getFinalOutput
+std::vector<std::string> ImportLogic::unreadableFiles() const
+{
+    return m_unreadable_files;
+}
+
 //! build the preview string with html style
 std::string ImportLogic::getPreview(const int& row) const
 {
     auto thumbnail = m_files.at(row)->thumbnail();
-    std::vector<std::vector<std::string>> ignore_scheme = getIgnoreScheme(thumbnail.size());
-    std::vector<std::string> color_scheme = getColorScheme(thumbnail.size());
-    std::vector<char> separator_scheme = getSeparatorScheme(thumbnail.size());
+    auto classification = lineClassification();
 
     std::string output = "";
+    IgnoreMatcher::Buffer buffer;
     for (int i = 0; i < thumbnail.size(); ++i) {
-
-        auto formated_line = thumbnail.at(i);
-        if (!ignore_scheme.at(i).empty())
-            DataImportUtils::eraseSubStrings(formated_line, ignore_scheme.at(i));
-
-        if (separator_scheme.at(i) != '!') {
-            auto temp_string_vec = DataImportUtils::split(formated_line, separator_scheme.at(i));
-            if (temp_string_vec.size() != 0) {
-                formated_line = temp_string_vec.at(0);
-                for (int j = 1; j < temp_string_vec.size(); ++j) {
-                    formated_line += std::string(std::string("<span style=\"background-color:")
-                                                 + color_scheme.at(i) + std::string("\">")
-                                                 + std::string(1, separator_scheme.at(i))
-                                                 + std::string("</span>"));
-                    formated_line += temp_string_vec.at(j);
-                }
-            }
-        }
-
-        if (formated_line == "") {
-            output += "<hr>";
-        } else {
-            output += std::string("<div><font color=\"") + color_scheme.at(i) + std::string("\">")
-                      + formated_line + std::string("</font>") + std::string("</div>");
-        }
+        const auto& entry = classification->entry(i);
+        auto line = classification->ignoreMatcher(entry.ignore_set).strip(thumbnail.at(i), buffer);
+        output += DataImportUtils::formatPreviewLine(line, entry.separator,
+                                                     classification->color(entry.color));
     }
     return output;
 }
@@ -127,64 +276,94 @@ std::string ImportLogic::getPreview(const int& row) const
 //! build the data string vector and return it for given file
 DataImportUtils::string_data ImportLogic::getData(const int& row) const
 {
-    auto file_lines = m_files.at(row)->file();
-    std::vector<std::vector<std::string>> ignore_scheme = getIgnoreScheme(file_lines.size());
-    std::vector<std::string> type_scheme = getTypeScheme(file_lines.size());
-    std::vector<char> separator_scheme = getSeparatorScheme(file_lines.size());
+    const auto& file_lines = m_files.at(row)->file();
+    auto classification = lineClassification();
 
     DataImportUtils::string_data output;
+    IgnoreMatcher::Buffer buffer;
     for (int i = 0; i < file_lines.size(); ++i) {
-        if (type_scheme.at(i) != "Data")
+        const auto& entry = classification->entry(i);
+        if (entry.type != LineType::Data)
             continue;
 
-        auto line = file_lines.at(i);
-        if (!ignore_scheme.at(i).empty())
-            DataImportUtils::eraseSubStrings(line, ignore_scheme.at(i));
+        auto line = std::string(
+            classification->ignoreMatcher(entry.ignore_set).strip(file_lines.at(i), buffer));
 
-        auto temp_string_vec = DataImportUtils::split(line, separator_scheme.at(i));
+        auto temp_string_vec = DataImportUtils::split(line, entry.separator);
         DataImportUtils::clean(temp_string_vec);
         output.push_back(temp_string_vec);
     }
     return output;
 }
 
+//! Build the data columns for given file. The file is streamed in chunks of lines, the line
+//! filters are applied per chunk and the tokens are converted into the column buffers without
+//! copying the lines, so that memory use doesn't depend on the file size beyond the values.
+DataImportUtils::numeric_data ImportLogic::getNumericData(const int& row) const
+{
+    const double nan = std::nan("");
+
+    DataImportUtils::numeric_data output;
+    size_t row_count = 0;
+    IgnoreMatcher::Buffer buffer;
+    auto classification = lineClassification();
+    auto process_chunk = [&](int first_line, const std::vector<std::string_view>& lines) {
+        for (int i = 0; i < lines.size(); ++i) {
+            const auto& entry = classification->entry(first_line + i);
+            if (entry.type != LineType::Data)
+                continue;
+
+            auto line = classification->ignoreMatcher(entry.ignore_set).strip(lines.at(i), buffer);
+
+            // missing values of short rows are nan, as for the transposed string data
+            size_t column = 0;
+            DataImportUtils::forEachToken(line, entry.separator, [&](auto token) {
+                if (column == output.size())
+                    output.emplace_back(row_count, nan);
+                output[column++].push_back(DataImportUtils::toDouble(token));
+            });
+            for (; column < output.size(); ++column)
+                output[column].push_back(nan);
+            ++row_count;
+        }
+        return true;
+    };
+    m_files.at(row)->readChunks(chunk_size, process_chunk);
+    return output;
+}
+
 //! Build the map of headers in the file with their associated column
 DataImportUtils::header_map ImportLogic::getHeader(const int& row) const
 {
-    auto file_lines = m_files.at(row)->file();
-    std::vector<std::vector<std::string>> ignore_scheme = getIgnoreScheme(file_lines.size());
-    std::vector<std::string> type_scheme = getTypeScheme(file_lines.size());
-    std::vector<char> separator_scheme = getSeparatorScheme(file_lines.size());
-
     DataImportUtils::header_map output;
-    for (int i = 0; i < file_lines.size(); ++i) {
-        if (type_scheme.at(i) == "Header") {
-
-            auto line = file_lines.at(i);
-            if (!ignore_scheme.at(i).empty())
-                DataImportUtils::eraseSubStrings(line, ignore_scheme.at(i));
-
-            auto temp_string_vec = DataImportUtils::split(line, separator_scheme.at(i));
-            DataImportUtils::clean(temp_string_vec);
-            for (int j = 0; j < temp_string_vec.size(); ++j) {
-                output.insert(std::make_pair(temp_string_vec.at(j), j));
+    IgnoreMatcher::Buffer buffer;
+    auto classification = lineClassification();
+    auto process_chunk = [&](int first_line, const std::vector<std::string_view>& lines) {
+        for (int i = 0; i < lines.size(); ++i) {
+            const auto& entry = classification->entry(first_line + i);
+            if (entry.type == LineType::Header) {
+
+                auto line = std::string(
+                    classification->ignoreMatcher(entry.ignore_set).strip(lines.at(i), buffer));
+
+                auto temp_string_vec = DataImportUtils::split(line, entry.separator);
+                DataImportUtils::clean(temp_string_vec);
+                for (int j = 0; j < temp_string_vec.size(); ++j) {
+                    output.insert(std::make_pair(temp_string_vec.at(j), j));
+                }
+                return false;
             }
-            break;
         }
-    }
+        return true;
+    };
+    m_files.at(row)->readChunks(chunk_size, process_chunk);
     return output;
 }
 
 //! Grab the data and header internally and then populate the data structure
 void ImportLogic::updateData(const int& row)
 {
-    auto headers = getHeader(row);
-    auto data = DataImportUtils::transpose(getData(row));
-
-    if (!headers.empty())
-        p_data_structure->setData(headers, data);
-    else
-        p_data_structure->setData(data);
+    fillDataStructure(row, *p_data_structure);
 }
 
 //! Grab the data and header internally and then populate the data structure
@@ -213,6 +392,40 @@ LineFilter* ImportLogic::typeInFilters(const std::string& type) const
     return nullptr;
 }
 
+//! Grab the data and header of the file and populate the given data structure. They are taken
+//! from the cache if the file was already parsed with the same filters. NeXus/HDF5 files are read
+//! directly, without the line filters. Return false if the file couldn't be read, the data
+//! structure is left empty then.
+bool ImportLogic::fillDataStructure(int row, DataStructure& data_structure) const
+{
+    const auto& path = m_files.at(row)->path();
+    if (NexusReader::isAvailable() && NexusReader::isNexusFile(path)) {
+        try {
+            NexusReader(path).fillDataStructure(data_structure);
+            return true;
+        } catch (const std::exception&) {
+            data_structure.setData(DataImportUtils::numeric_data());
+            return false;
+        }
+    }
+
+    DataImportUtils::header_map headers;
+    DataImportUtils::numeric_data data;
+    const auto signature = p_cache ? filterSignature() : std::string();
+    if (!p_cache || !p_cache->load(path, signature, headers, data)) {
+        headers = getHeader(row);
+        data = getNumericData(row);
+        if (p_cache)
+            p_cache->store(path, signature, headers, data);
+    }
+
+    if (!headers.empty())
+        data_structure.setData(headers, std::move(data));
+    else
+        data_structure.setData(std::move(data));
+    return true;
+}
+
 //! build the preview string with html style
 void ImportLogic::initSeparators()
 {
@@ -226,42 +439,19 @@ void ImportLogic::initSeparators()
     m_separators.insert(std::pair<std::string, char>("Apostrophe (\")", '\"'));
 }
 
-//! Get the color scheme
-std::vector<std::string> ImportLogic::getColorScheme(const int& length) const
-{
-    std::vector<std::string> output(length, "black");
-    for (auto& line_filter : m_line_filters) {
-        line_filter->processColors(output);
-    }
-    return output;
-}
-
-//! Get the separator scheme
-std::vector<char> ImportLogic::getSeparatorScheme(const int& length) const
-{
-    std::vector<char> output(length, '!');
-    for (auto& line_filter : m_line_filters) {
-        line_filter->processSeparator(output);
-    }
-    return output;
-}
-
-//! Get the type scheme
-std::vector<std::string> ImportLogic::getTypeScheme(const int& length) const
+//! Describe the settings of all filters affecting the parsed header and data
+std::string ImportLogic::filterSignature() const
 {
-    std::vector<std::string> output(length, "Comments");
-    for (auto& line_filter : m_line_filters) {
-        line_filter->processType(output);
-    }
-    return output;
-}
-
-//! Get the type scheme
-std::vector<std::vector<std::string>> ImportLogic::getIgnoreScheme(const int& length) const
-{
-    std::vector<std::vector<std::string>> output(length, std::vector<std::string>());
-    for (auto& line_filter : m_line_filters) {
-        line_filter->processIgnore(output);
+    std::string output;
+    for (const auto& line_filter : m_line_filters) {
+        if (!line_filter->active())
+            continue;
+        output += line_filter->type() + '|' + line_filter->separatorChar() + '|'
+                  + std::to_string(line_filter->start()) + '|'
+                  + std::to_string(line_filter->end()) + '|';
+        for (const auto& ignore_string : line_filter->ignoreStrings())
+            output += std::to_string(ignore_string.size()) + ':' + ignore_string;
+        output += '\n';
     }
     return output;
 }
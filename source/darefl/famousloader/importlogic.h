@@ -10,15 +10,21 @@
 #ifndef DAREFL_FAMOUSLOADER_IMPORTLOGIC_H
 #define DAREFL_FAMOUSLOADER_IMPORTLOGIC_H
 
+#include <darefl/famousloader/importcache.h>
 #include <darefl/famousloader/importdatastructure.h>
 #include <darefl/famousloader/importfile.h>
+#include <darefl/famousloader/importformatsniffer.h>
+#include <darefl/famousloader/importlineclassification.h>
 #include <darefl/famousloader/importlinefilter.h>
 #include <darefl/famousloader/importoutput.h>
 #include <darefl/famousloader/importutils.h>
 
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace DataImportLogic
@@ -28,6 +34,9 @@ namespace DataImportLogic
 class ImportLogic
 {
 public:
+    //! Receives the number of processed files, returns true to cancel the import
+    using progress_callback_t = std::function<bool(int)>;
+
     ImportLogic();
     ~ImportLogic() = default;
 
@@ -35,9 +44,11 @@ public:
     void removeLineFilter(LineFilter* block_ptr);
     void setLineFilterOrder(std::vector<LineFilter*> filter_order);
     std::vector<LineFilter*> lineFilterOrder() const;
+    std::shared_ptr<const LineClassification> lineClassification() const;
 
     std::string getPreview(const int& row) const;
     DataImportUtils::string_data getData(const int& row) const;
+    DataImportUtils::numeric_data getNumericData(const int& row) const;
     DataImportUtils::header_map getHeader(const int& row) const;
     void updateData(const int& row);
     DataStructure* dataStructure() const;
@@ -45,21 +56,30 @@ public:
     LineFilter* nameInFilters(const std::string& name) const;
     LineFilter* typeInFilters(const std::string& type) const;
     void setFiles(const std::vector<std::string>& file_paths);
+    int fileCount() const;
+    void setCacheDirectory(const std::string& directory);
+    std::string filterSignature() const;
+    const ImportFile* importFile(const int& row) const;
+    SniffedFormat detectFormat(const int& row);
 
-    ImportOutput getFinalOutput();
+    ImportOutput getFinalOutput(const progress_callback_t& callback = {});
+    std::vector<std::string> unreadableFiles() const;
 
 private:
+    bool fillDataStructure(int row, DataStructure& data_structure) const;
     void initSeparators();
-    std::vector<std::string> getColorScheme(const int& length) const;
-    std::vector<char> getSeparatorScheme(const int& length) const;
-    std::vector<std::string> getTypeScheme(const int& length) const;
-    std::vector<std::vector<std::string>> getIgnoreScheme(const int& length) const;
 
 private:
     std::vector<std::unique_ptr<ImportFile>> m_files;
     std::vector<std::unique_ptr<LineFilter>> m_line_filters;
     std::map<std::string, char> m_separators;
     std::unique_ptr<DataStructure> p_data_structure;
+    std::unique_ptr<ImportCache> p_cache;
+    std::vector<std::string> m_unreadable_files;
+
+    mutable std::mutex m_classification_mutex;
+    mutable std::shared_ptr<const LineClassification> p_classification;
+    mutable std::vector<std::pair<const LineFilter*, size_t>> m_classification_key;
 };
 
 } // namespace DataImportLogic
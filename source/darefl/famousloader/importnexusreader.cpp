@@ -0,0 +1,318 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include <darefl/famousloader/importdatastructure.h>
+#include <darefl/famousloader/importnexusreader.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef DAREFL_HAS_HDF5
+#include <hdf5.h>
+#include <mutex>
+#include <type_traits>
+#endif
+
+namespace
+{
+//! Dataset names accepted for the columns of a curve, in the order of NexusReader::Columns
+const std::vector<std::vector<std::string>> column_names = {{"Q", "Qz", "q", "qz"},
+                                                            {"R", "reflectivity", "data"},
+                                                            {"dR", "R_error", "errors"},
+                                                            {"dQ", "Q_resolution", "dq"}};
+
+//! Column headers of the data structure, in the order of NexusReader::Columns
+const std::vector<std::string> column_headers = {"Q", "R", "dR", "dQ"};
+const std::vector<std::string> column_types = {"Axis", "Intensity", "Intensity error",
+                                               "Axis resolution"};
+
+//! Signature at the start of every HDF5 file
+const char hdf5_signature[8] = {'\x89', 'H', 'D', 'F', '\r', '\n', '\x1a', '\n'};
+
+std::string joinPath(const std::string& group, const std::string& name)
+{
+    return group == "/" ? "/" + name : group + "/" + name;
+}
+
+#ifdef DAREFL_HAS_HDF5
+static_assert(std::is_same<hid_t, int64_t>::value, "HDF5 identifiers are expected as int64_t");
+
+//! The HDF5 library isn't necessarily built thread-safe, files are imported in parallel
+std::mutex& hdf5Mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+//! Closes the HDF5 identifier when going out of scope
+class Handle
+{
+public:
+    Handle(hid_t id, herr_t (*close)(hid_t)) : m_id(id), m_close(close) {}
+    ~Handle()
+    {
+        if (m_id >= 0)
+            m_close(m_id);
+    }
+    Handle(const Handle&) = delete;
+    Handle& operator=(const Handle&) = delete;
+    operator hid_t() const { return m_id; }
+    bool valid() const { return m_id >= 0; }
+
+private:
+    hid_t m_id;
+    herr_t (*m_close)(hid_t);
+};
+
+bool isDataset(hid_t file, const std::string& path)
+{
+    if (H5Lexists(file, path.c_str(), H5P_DEFAULT) <= 0)
+        return false;
+    Handle dataset(H5Dopen2(file, path.c_str(), H5P_DEFAULT), H5Dclose);
+    return dataset.valid();
+}
+
+//! Collects the groups containing a link named like a Q dataset
+herr_t collectGroups(hid_t, const char* name, const H5L_info_t*, void* data)
+{
+    const std::string path = std::string("/") + name;
+    const auto separator = path.rfind('/');
+    const auto& q_names = column_names.front();
+    if (std::find(q_names.begin(), q_names.end(), path.substr(separator + 1)) != q_names.end()) {
+        auto& groups = *static_cast<std::vector<std::string>*>(data);
+        groups.push_back(separator == 0 ? "/" : path.substr(0, separator));
+    }
+    return 0;
+}
+#endif
+
+} // namespace
+
+namespace DataImportLogic
+{
+
+#ifdef DAREFL_HAS_HDF5
+
+//! Open the file, throws if it isn't a readable HDF5 file
+NexusReader::NexusReader(std::string path) : m_path(std::move(path))
+{
+    std::lock_guard<std::mutex> lock(hdf5Mutex());
+    H5Eset_auto2(H5E_DEFAULT, nullptr, nullptr);
+    m_file = H5Fopen(m_path.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    if (m_file < 0)
+        throw std::runtime_error("NexusReader: can't open HDF5 file '" + m_path + "'");
+}
+
+//! The destructor, closes the file
+NexusReader::~NexusReader()
+{
+    std::lock_guard<std::mutex> lock(hdf5Mutex());
+    H5Fclose(m_file);
+}
+
+//! Whether HDF5 files can be read
+bool NexusReader::isAvailable()
+{
+    return true;
+}
+
+//! Return the groups holding a reflectivity curve, in the order of the file
+std::vector<std::string> NexusReader::curves() const
+{
+    std::vector<std::string> groups;
+    {
+        std::lock_guard<std::mutex> lock(hdf5Mutex());
+        H5Lvisit(m_file, H5_INDEX_NAME, H5_ITER_INC, collectGroups, &groups);
+    }
+
+    std::vector<std::string> output;
+    for (const auto& group : groups)
+        if (!datasetPath(group, Q).empty() && !datasetPath(group, R).empty()
+            && std::find(output.begin(), output.end(), group) == output.end())
+            output.push_back(group);
+    return output;
+}
+
+//! Return the number of points of the curve
+size_t NexusReader::pointCount(const std::string& curve) const
+{
+    const auto path = datasetPath(curve, Q);
+    if (path.empty())
+        throw std::runtime_error("NexusReader: no curve in '" + curve + "'");
+
+    std::lock_guard<std::mutex> lock(hdf5Mutex());
+    Handle dataset(H5Dopen2(m_file, path.c_str(), H5P_DEFAULT), H5Dclose);
+    Handle space(H5Dget_space(dataset), H5Sclose);
+    return static_cast<size_t>(H5Sget_simple_extent_npoints(space));
+}
+
+//! Read count points starting at the given offset of the Q, R, dR and dQ datasets of the curve,
+//! only the selected part of the datasets is read. The columns of missing datasets are empty.
+DataImportUtils::numeric_data NexusReader::read(const std::string& curve, size_t offset,
+                                                size_t count) const
+{
+    DataImportUtils::numeric_data output(column_names.size());
+    for (size_t column = 0; column < column_names.size(); ++column) {
+        const auto path = datasetPath(curve, static_cast<Columns>(column));
+        if (path.empty()) {
+            if (column == Q || column == R)
+                throw std::runtime_error("NexusReader: no curve in '" + curve + "'");
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(hdf5Mutex());
+        Handle dataset(H5Dopen2(m_file, path.c_str(), H5P_DEFAULT), H5Dclose);
+        Handle file_space(H5Dget_space(dataset), H5Sclose);
+        if (H5Sget_simple_extent_ndims(file_space) != 1)
+            throw std::runtime_error("NexusReader: dataset '" + path + "' isn't one-dimensional");
+
+        hsize_t size = 0;
+        H5Sget_simple_extent_dims(file_space, &size, nullptr);
+        const hsize_t start = std::min<hsize_t>(offset, size);
+        const hsize_t selected = std::min<hsize_t>(count, size - start);
+        auto& values = output[column];
+        values.resize(selected);
+        if (selected == 0)
+            continue;
+
+        H5Sselect_hyperslab(file_space, H5S_SELECT_SET, &start, nullptr, &selected, nullptr);
+        Handle memory_space(H5Screate_simple(1, &selected, nullptr), H5Sclose);
+        if (H5Dread(dataset, H5T_NATIVE_DOUBLE, memory_space, file_space, H5P_DEFAULT,
+                    values.data())
+            < 0)
+            throw std::runtime_error("NexusReader: can't read dataset '" + path + "'");
+    }
+    return output;
+}
+
+//! Return the units attribute of the column of the curve, empty if there is none
+std::string NexusReader::unit(const std::string& curve, Columns column) const
+{
+    const auto path = datasetPath(curve, column);
+    if (path.empty())
+        return {};
+
+    std::lock_guard<std::mutex> lock(hdf5Mutex());
+    if (H5Aexists_by_name(m_file, path.c_str(), "units", H5P_DEFAULT) <= 0)
+        return {};
+    Handle attribute(H5Aopen_by_name(m_file, path.c_str(), "units", H5P_DEFAULT, H5P_DEFAULT),
+                     H5Aclose);
+    Handle type(H5Aget_type(attribute), H5Tclose);
+    if (H5Tget_class(type) != H5T_STRING)
+        return {};
+
+    std::string output;
+    if (H5Tis_variable_str(type) > 0) {
+        Handle memory_type(H5Tcopy(H5T_C_S1), H5Tclose);
+        H5Tset_size(memory_type, H5T_VARIABLE);
+        char* text = nullptr;
+        if (H5Aread(attribute, memory_type, &text) >= 0 && text) {
+            output = text;
+            H5free_memory(text);
+        }
+    } else {
+        std::vector<char> text(H5Tget_size(type) + 1, '\0');
+        if (H5Aread(attribute, type, text.data()) >= 0)
+            output = text.data();
+    }
+    return output;
+}
+
+//! Return the path of the dataset of the column of the curve, empty if there is none
+std::string NexusReader::datasetPath(const std::string& curve, Columns column) const
+{
+    std::lock_guard<std::mutex> lock(hdf5Mutex());
+    for (const auto& name : column_names.at(column)) {
+        const auto path = joinPath(curve, name);
+        if (isDataset(m_file, path))
+            return path;
+    }
+    return {};
+}
+
+#else
+
+NexusReader::NexusReader(std::string path) : m_path(std::move(path))
+{
+    throw std::runtime_error("NexusReader: built without HDF5 support, can't read '" + m_path
+                             + "'");
+}
+
+NexusReader::~NexusReader() = default;
+
+bool NexusReader::isAvailable()
+{
+    return false;
+}
+
+std::vector<std::string> NexusReader::curves() const
+{
+    return {};
+}
+
+size_t NexusReader::pointCount(const std::string&) const
+{
+    return 0;
+}
+
+DataImportUtils::numeric_data NexusReader::read(const std::string&, size_t, size_t) const
+{
+    return {};
+}
+
+std::string NexusReader::unit(const std::string&, Columns) const
+{
+    return {};
+}
+
+std::string NexusReader::datasetPath(const std::string&, Columns) const
+{
+    return {};
+}
+
+#endif
+
+//! Whether the file starts with the HDF5 signature
+bool NexusReader::isNexusFile(const std::string& path)
+{
+    char signature[sizeof(hdf5_signature)] = {};
+    std::ifstream file(path, std::ios::binary);
+    file.read(signature, sizeof(signature));
+    return file && std::memcmp(signature, hdf5_signature, sizeof(signature)) == 0;
+}
+
+//! Fill the data structure with the first curve of the file: Q as axis, R as intensity, dR as
+//! intensity error and dQ as axis resolution
+void NexusReader::fillDataStructure(DataStructure& data_structure) const
+{
+    auto curve_groups = curves();
+    if (curve_groups.empty())
+        throw std::runtime_error("NexusReader: no reflectivity curve in '" + m_path + "'");
+    const auto& curve = curve_groups.front();
+
+    auto data = read(curve);
+    DataImportUtils::header_map headers;
+    for (size_t column = 0; column < column_headers.size(); ++column)
+        if (!data.at(column).empty())
+            headers.emplace(column_headers.at(column), column);
+    data_structure.setData(headers, std::move(data));
+
+    for (const auto& [header, column] : headers) {
+        auto data_column = data_structure.column(header);
+        data_column->setName(header);
+        data_column->setType(column_types.at(column));
+        auto column_unit = unit(curve, static_cast<Columns>(column));
+        data_column->setUnit(column_unit.empty() ? "a.u." : column_unit);
+        data_column->setMultiplier(1.0);
+    }
+}
+
+} // namespace DataImportLogic
@@ -0,0 +1,64 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#ifndef DAREFL_FAMOUSLOADER_IMPORTNEXUSREADER_H
+#define DAREFL_FAMOUSLOADER_IMPORTNEXUSREADER_H
+
+#include <darefl/famousloader/importutils.h>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace DataImportLogic
+{
+
+class DataStructure;
+
+//! Reads reflectivity curves directly from NeXus/HDF5 files. A curve is a group holding a Q and
+//! an R dataset, with optional dR and dQ datasets; the values are read as doubles through
+//! hyperslab selections, without any text conversion.
+//!
+//! Only functional when built with HDF5 (DAREFL_USE_HDF5), otherwise opening a file throws.
+class NexusReader
+{
+public:
+    //! Columns of a curve, in the order of the read data
+    enum Columns { Q, R, DR, DQ };
+
+    NexusReader(std::string path);
+    ~NexusReader();
+
+    NexusReader(const NexusReader&) = delete;
+    NexusReader& operator=(const NexusReader&) = delete;
+
+    static bool isAvailable();
+    static bool isNexusFile(const std::string& path);
+
+    std::vector<std::string> curves() const;
+    size_t pointCount(const std::string& curve) const;
+    DataImportUtils::numeric_data
+    read(const std::string& curve, size_t offset = 0,
+         size_t count = std::numeric_limits<size_t>::max()) const;
+    std::string unit(const std::string& curve, Columns column) const;
+
+    void fillDataStructure(DataStructure& data_structure) const;
+
+private:
+    std::string datasetPath(const std::string& curve, Columns column) const;
+
+private:
+    std::string m_path;
+    int64_t m_file{-1}; //! HDF5 identifier of the open file
+};
+
+} // namespace DataImportLogic
+
+#endif // DAREFL_FAMOUSLOADER_IMPORTNEXUSREADER_H
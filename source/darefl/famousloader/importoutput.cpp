@@ -17,7 +17,7 @@ namespace DataImportLogic
 // -------------------------------------------------
 //! This is the container for one data set
 
-//! This is the constructor
+//! This is the constructor. The n-th intensity error column belongs to the n-th intensity column.
 ParsedFileOutptut::ParsedFileOutptut(const DataStructure& data_structure) : m_axis_colum()
 {
     for (int i = 0; i < data_structure.columnCount(); ++i) {
@@ -29,6 +29,10 @@ ParsedFileOutptut::ParsedFileOutptut(const DataStructure& data_structure) : m_ax
 
         if (column->type() == "Axis") {
             m_axis_colum = std::make_unique<DataColumn>(*column);
+        } else if (column->type() == "Axis resolution") {
+            m_resolution_colum = std::make_unique<DataColumn>(*column);
+        } else if (column->type() == "Intensity error") {
+            m_error_colums.push_back(std::make_unique<DataColumn>(*column));
         } else {
             m_value_colums.push_back(std::make_unique<DataColumn>(*column));
         }
@@ -59,6 +63,12 @@ std::string ParsedFileOutptut::axisUnit() const
     return (hasAxis()) ? (m_axis_colum->unit()) : ("a.u.");
 }
 
+//! This will return the resolution of the axis if present
+std::vector<double> ParsedFileOutptut::axisResolution() const
+{
+    return (m_resolution_colum) ? (m_resolution_colum->finalValues()) : (std::vector<double>());
+}
+
 //! This will return the count of the data vector
 int ParsedFileOutptut::dataCount() const
 {
@@ -89,6 +99,13 @@ std::string ParsedFileOutptut::dataUnit(int column) const
     return m_value_colums.at(column)->unit();
 }
 
+//! This will return the errors of the said column if present
+std::vector<double> ParsedFileOutptut::dataErrors(int column) const
+{
+    return (column < m_error_colums.size()) ? (m_error_colums.at(column)->finalValues())
+                                            : (std::vector<double>());
+}
+
 // -------------------------------------------------
 //! This is the import structure for multiple files
 ImportOutput::ImportOutput() : m_target("New group ...") {}
@@ -33,16 +33,20 @@ public:
     std::vector<double> axis() const;
     std::string axisName() const;
     std::string axisUnit() const;
+    std::vector<double> axisResolution() const;
 
     int dataCount() const;
     std::vector<double> data(int column) const;
     std::string dataType(int column) const;
     std::string dataName(int column) const;
     std::string dataUnit(int column) const;
+    std::vector<double> dataErrors(int column) const;
 
 private:
     std::unique_ptr<DataColumn> m_axis_colum;
+    std::unique_ptr<DataColumn> m_resolution_colum;
     std::vector<std::unique_ptr<DataColumn>> m_value_colums;
+    std::vector<std::unique_ptr<DataColumn>> m_error_colums;
 };
 
 // -------------------------------------------------
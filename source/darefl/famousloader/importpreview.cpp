@@ -0,0 +1,128 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include <darefl/famousloader/importlogic.h>
+#include <darefl/famousloader/importpreview.h>
+#include <darefl/famousloader/importutils.h>
+
+#include <algorithm>
+
+namespace
+{
+//! Maximum number of formatted lines kept, the cache is emptied once exceeded
+const int max_cached_lines = 4096;
+} // namespace
+
+namespace DataImportLogic
+{
+
+//! This is the constructor
+ImportPreview::ImportPreview(const ImportLogic* import_logic) : p_import_logic(import_logic) {}
+
+//! Set the file of the given row, a negative row means no file. The cached lines are only
+//! discarded if the file is different.
+void ImportPreview::setFile(int row)
+{
+    if (row >= p_import_logic->fileCount())
+        row = -1;
+    const std::string path = row < 0 ? std::string() : p_import_logic->importFile(row)->path();
+    if (row == m_row && path == m_path)
+        return;
+
+    clear();
+    m_row = row;
+    m_path = path;
+}
+
+//! Getter for the number of lines of the current file
+int ImportPreview::lineCount() const
+{
+    auto current_file = file();
+    return current_file ? current_file->lineCount() : 0;
+}
+
+//! Return the formatted line, using the cached one if its format didn't change
+const std::string& ImportPreview::line(int line_number)
+{
+    static const std::string empty_line;
+    auto current_file = file();
+    if (!current_file)
+        return empty_line;
+
+    auto classification = p_import_logic->lineClassification();
+    const auto& entry = classification->entry(line_number);
+    const auto& color = classification->color(entry.color);
+    const auto& ignore_strings = classification->ignoreSet(entry.ignore_set);
+    const int format = formatId(entry.separator, color, ignore_strings);
+
+    auto found = m_lines.find(line_number);
+    if (found != m_lines.end() && found->second.format == format)
+        return found->second.html;
+
+    if (found == m_lines.end() && m_lines.size() >= max_cached_lines) {
+        clear();
+        return line(line_number);
+    }
+
+    auto& formatted_line = m_lines[line_number];
+    formatted_line.format = format;
+    IgnoreMatcher::Buffer buffer;
+    auto line = classification->ignoreMatcher(entry.ignore_set).strip(
+        current_file->line(line_number), buffer);
+    formatted_line.html = DataImportUtils::formatPreviewLine(line, entry.separator, color);
+    return formatted_line.html;
+}
+
+//! Return the html of the given range of lines, clipped to the file
+std::string ImportPreview::html(int first_line, int count)
+{
+    std::string output;
+    const int end = std::min(first_line + count, lineCount());
+    for (int i = std::max(first_line, 0); i < end; ++i)
+        output += line(i);
+    return output;
+}
+
+//! Getter for the number of formatted lines in the cache
+int ImportPreview::cachedLineCount() const
+{
+    return m_lines.size();
+}
+
+//! Return the id of the format, storing it if it is new
+int ImportPreview::formatId(char separator, const std::string& color,
+                            const std::vector<std::string>& ignore_strings)
+{
+    auto found = std::find_if(m_formats.begin(), m_formats.end(), [&](const auto& format) {
+        return format.separator == separator && format.color == color
+               && format.ignore_strings == ignore_strings;
+    });
+    if (found != m_formats.end())
+        return found - m_formats.begin();
+    m_formats.push_back({separator, color, ignore_strings});
+    return m_formats.size() - 1;
+}
+
+//! Discard the formatted lines and their formats
+void ImportPreview::clear()
+{
+    m_lines.clear();
+    m_formats.clear();
+}
+
+//! Return the current file, or nullptr if the file list doesn't contain it anymore
+const ImportFile* ImportPreview::file() const
+{
+    if (m_row < 0 || m_row >= p_import_logic->fileCount())
+        return nullptr;
+    auto current_file = p_import_logic->importFile(m_row);
+    return current_file->path() == m_path ? current_file : nullptr;
+}
+
+} // namespace DataImportLogic
@@ -0,0 +1,69 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#ifndef DAREFL_FAMOUSLOADER_IMPORTPREVIEW_H
+#define DAREFL_FAMOUSLOADER_IMPORTPREVIEW_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace DataImportLogic
+{
+
+class ImportFile;
+class ImportLogic;
+
+//! The html preview of a file, formatted on demand for the requested range of lines only. The
+//! formatted lines are cached together with the format they were built with, and formatted again
+//! only once the line filters changed the format of the line. The file is looked up in ImportLogic
+//! by its row on every access, so the preview is empty once the file list no longer contains it.
+class ImportPreview
+{
+public:
+    ImportPreview(const ImportLogic* import_logic);
+
+    void setFile(int row);
+    int lineCount() const;
+
+    const std::string& line(int line_number);
+    std::string html(int first_line, int count);
+
+    int cachedLineCount() const;
+
+private:
+    //! The part of the line classification affecting the preview
+    struct Format {
+        char separator;
+        std::string color;
+        std::vector<std::string> ignore_strings;
+    };
+
+    //! The formatted line and the id of its format
+    struct FormattedLine {
+        int format;
+        std::string html;
+    };
+
+    int formatId(char separator, const std::string& color,
+                 const std::vector<std::string>& ignore_strings);
+    void clear();
+    const ImportFile* file() const;
+
+private:
+    const ImportLogic* p_import_logic{nullptr};
+    int m_row{-1};
+    std::string m_path;
+    std::vector<Format> m_formats;
+    std::unordered_map<int, FormattedLine> m_lines;
+};
+
+} // namespace DataImportLogic
+
+#endif // DAREFL_FAMOUSLOADER_IMPORTPREVIEW_H
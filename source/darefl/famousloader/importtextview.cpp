@@ -7,13 +7,16 @@
 //
 // ************************************************************************** //
 
+#include <darefl/famousloader/importpreview.h>
 #include <darefl/famousloader/importtextview.h>
 
 #include <QAbstractTextDocumentLayout>
+#include <QCoreApplication>
 #include <QPainter>
 #include <QScrollBar>
 #include <QTextBlock>
 #include <QTextDocument>
+#include <QWheelEvent>
 
 namespace DataImportGui
 {
@@ -23,6 +26,12 @@ ImportTextView::ImportTextView(QWidget* parent) : QTextEdit(parent)
     setReadOnly(true);
     lineNumberArea = new LineNumberArea(this);
 
+    // the own scroll bar runs over the whole file, the document only holds the visible lines
+    setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    p_scroll_bar = new QScrollBar(Qt::Vertical, this);
+    p_scroll_bar->setRange(0, 0);
+    connect(p_scroll_bar, &QScrollBar::valueChanged, this, &ImportTextView::renderVisibleLines);
+
     connect(this->document(), &QTextDocument::blockCountChanged, this,
             &ImportTextView::updateLineNumberAreaWidth);
     connect(this->document()->documentLayout(), &QAbstractTextDocumentLayout::update, this,
@@ -35,10 +44,53 @@ ImportTextView::ImportTextView(QWidget* parent) : QTextEdit(parent)
     setLineWrapMode(QTextEdit::NoWrap);
 }
 
+//! Set the preview providing the formatted lines
+void ImportTextView::setPreview(DataImportLogic::ImportPreview* preview)
+{
+    p_preview = preview;
+    refreshPreview();
+}
+
+//! Render the visible lines again, after the file or the line filters changed
+void ImportTextView::refreshPreview()
+{
+    updateScrollRange();
+    renderVisibleLines();
+}
+
+//! Render only the lines of the preview fitting into the viewport
+void ImportTextView::renderVisibleLines()
+{
+    m_first_line = p_scroll_bar->value();
+    if (!p_preview || p_preview->lineCount() == 0) {
+        setHtml("");
+    } else {
+        auto html = p_preview->html(m_first_line, visibleLineCount());
+        setHtml(QString::fromStdString(html));
+    }
+    updateLineNumberAreaWidth(0);
+    lineNumberArea->update();
+}
+
+//! Number of lines fitting into the viewport, including the partially visible one
+int ImportTextView::visibleLineCount() const
+{
+    return viewport()->height() / qMax(1, fontMetrics().lineSpacing()) + 1;
+}
+
+//! Adapt the range of the scroll bar to the number of lines and the size of the viewport
+void ImportTextView::updateScrollRange()
+{
+    const int line_count = p_preview ? p_preview->lineCount() : 0;
+    const int page = qMax(1, visibleLineCount() - 1);
+    p_scroll_bar->setPageStep(page);
+    p_scroll_bar->setRange(0, qMax(0, line_count - page));
+}
+
 int ImportTextView::lineNumberAreaWidth()
 {
     int digits = 1;
-    int max = qMax(1, document()->blockCount());
+    int max = qMax(1, p_preview ? p_preview->lineCount() : document()->blockCount());
     while (max >= 10) {
         max /= 10;
         ++digits;
@@ -51,7 +103,7 @@ int ImportTextView::lineNumberAreaWidth()
 
 void ImportTextView::updateLineNumberAreaWidth(int /* newBlockCount */)
 {
-    setViewportMargins(lineNumberAreaWidth(), 0, 0, 0);
+    setViewportMargins(lineNumberAreaWidth(), 0, p_scroll_bar->sizeHint().width(), 0);
 }
 
 void ImportTextView::updateLineNumberArea(const QRectF& rect)
@@ -68,6 +120,17 @@ void ImportTextView::resizeEvent(QResizeEvent* e)
 
     QRect cr = contentsRect();
     lineNumberArea->setGeometry(QRect(cr.left(), cr.top(), lineNumberAreaWidth(), cr.height()));
+
+    const int scroll_width = p_scroll_bar->sizeHint().width();
+    p_scroll_bar->setGeometry(
+        QRect(cr.right() - scroll_width + 1, cr.top(), scroll_width, cr.height()));
+    refreshPreview();
+}
+
+//! Scroll over the lines of the file instead of the rendered document
+void ImportTextView::wheelEvent(QWheelEvent* event)
+{
+    QCoreApplication::sendEvent(p_scroll_bar, event);
 }
 
 void ImportTextView::highlightCurrentLine()
@@ -147,7 +210,7 @@ void ImportTextView::lineNumberAreaPaintEvent(QPaintEvent* event)
 
     while (block.isValid() && top <= event->rect().bottom()) {
         if (block.isVisible() && bottom >= event->rect().top()) {
-            QString number = QString::number(blockNumber);
+            QString number = QString::number(m_first_line + blockNumber);
             painter.setPen(Qt::black);
             painter.drawText(0, top, lineNumberArea->width(), fontMetrics().height(),
                              Qt::AlignRight, number);
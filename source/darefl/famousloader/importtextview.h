@@ -15,15 +15,24 @@
 QT_BEGIN_NAMESPACE
 class QPaintEvent;
 class QResizeEvent;
+class QScrollBar;
 class QSize;
+class QWheelEvent;
 class QWidget;
 QT_END_NAMESPACE
 
+namespace DataImportLogic
+{
+class ImportPreview;
+}
+
 namespace DataImportGui
 {
 
 class LineNumberArea;
 
+//! Shows the preview of a file. Only the lines fitting into the viewport are rendered, the
+//! scroll bar runs over the lines of the whole file.
 class ImportTextView : public QTextEdit
 {
     Q_OBJECT
@@ -31,20 +40,31 @@ class ImportTextView : public QTextEdit
 public:
     ImportTextView(QWidget* parent = nullptr);
 
+    void setPreview(DataImportLogic::ImportPreview* preview);
+    void refreshPreview();
+
     void lineNumberAreaPaintEvent(QPaintEvent* event);
     int lineNumberAreaWidth();
     int getFirstVisibleBlockId();
 
 protected:
     void resizeEvent(QResizeEvent* event) override;
+    void wheelEvent(QWheelEvent* event) override;
 
 private slots:
     void updateLineNumberAreaWidth(int newBlockCount);
     void highlightCurrentLine();
     void updateLineNumberArea(const QRectF& rect);
+    void renderVisibleLines();
 
 private:
+    int visibleLineCount() const;
+    void updateScrollRange();
+
     QWidget* lineNumberArea;
+    QScrollBar* p_scroll_bar{nullptr};
+    DataImportLogic::ImportPreview* p_preview{nullptr};
+    int m_first_line{0};
 };
 
 class LineNumberArea : public QWidget
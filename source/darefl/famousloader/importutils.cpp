@@ -9,8 +9,90 @@
 
 #include <darefl/famousloader/importutils.h>
 
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <functional>
-#include <sstream>
+
+namespace
+{
+
+//! Powers of ten which are exactly representable as double
+const double exact_powers_of_ten[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                      1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                      1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+//! Fast conversion of plain decimal numbers. Succeeds only if the mantissa and the power of ten
+//! are both exact doubles, so that a single multiplication or division gives the correctly
+//! rounded result.
+bool fastToDouble(std::string_view input, double& value)
+{
+    const char* pos = input.data();
+    const char* end = pos + input.size();
+
+    bool negative = false;
+    if (pos != end && (*pos == '-' || *pos == '+'))
+        negative = *pos++ == '-';
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool has_digits = false;
+    auto add_digit = [&](char c) {
+        has_digits = true;
+        if (mantissa == 0 && c == '0')
+            return true;
+        if (++digits > 19)
+            return false;
+        mantissa = mantissa * 10 + static_cast<uint64_t>(c - '0');
+        return true;
+    };
+
+    for (; pos != end && isDigit(*pos); ++pos)
+        if (!add_digit(*pos))
+            return false;
+    if (pos != end && *pos == '.') {
+        for (++pos; pos != end && isDigit(*pos); ++pos, --exponent)
+            if (!add_digit(*pos))
+                return false;
+    }
+    if (!has_digits)
+        return false;
+
+    if (pos != end && (*pos == 'e' || *pos == 'E')) {
+        ++pos;
+        bool negative_exponent = false;
+        if (pos != end && (*pos == '-' || *pos == '+'))
+            negative_exponent = *pos++ == '-';
+        if (pos == end || !isDigit(*pos))
+            return false;
+        int explicit_exponent = 0;
+        for (; pos != end && isDigit(*pos); ++pos) {
+            if (explicit_exponent > 1000)
+                return false;
+            explicit_exponent = explicit_exponent * 10 + (*pos - '0');
+        }
+        exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+    }
+
+    if (pos != end || mantissa > (uint64_t(1) << 53) || exponent < -22 || exponent > 22)
+        return false;
+
+    value = static_cast<double>(mantissa);
+    value = exponent < 0 ? value / exact_powers_of_ten[-exponent]
+                         : value * exact_powers_of_ten[exponent];
+    if (negative)
+        value = -value;
+    return true;
+}
+
+} // namespace
 
 namespace DataImportUtils
 {
@@ -18,15 +100,36 @@ namespace DataImportUtils
 //! Standard function to handle spinting
 std::vector<std::string> split(const std::string& s, char delim)
 {
-    std::stringstream ss(s);
-    std::string item;
     std::vector<std::string> elems;
-    while (std::getline(ss, item, delim)) {
-        elems.push_back(item);
+    const std::string_view view(s);
+    size_t begin = 0;
+    while (begin < view.size()) {
+        size_t end = view.find(delim, begin);
+        if (end == std::string_view::npos)
+            end = view.size();
+        elems.emplace_back(view.substr(begin, end - begin));
+        begin = end + 1;
     }
     return elems;
 }
 
+//! Convert the string to double. Plain decimal numbers are converted directly, everything else
+//! (leading spaces, trailing characters, nan, inf, long mantissa) falls back to std::strtod
+double toDouble(std::string_view input)
+{
+    double value;
+    if (fastToDouble(input, value))
+        return value;
+
+    const std::string buffer(input);
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtod(buffer.c_str(), &end);
+    if (end == buffer.c_str() || errno == ERANGE)
+        return std::nan("");
+    return value;
+}
+
 //! Cleans the vector of strings provided by removing empty parts
 void clean(std::vector<std::string>& input)
 {
@@ -61,4 +164,27 @@ void eraseAllSubString(std::string& main_string, const std::string& to_erase)
     }
 }
 
+//! Format a line of the preview as html, highlighting the separators in the given color. Empty
+//! lines are shown as horizontal rule, the separator '!' means that the line isn't split.
+std::string formatPreviewLine(std::string_view line, char separator, const std::string& color)
+{
+    auto formated_line = std::string(line);
+    if (separator != '!') {
+        auto temp_string_vec = split(formated_line, separator);
+        if (temp_string_vec.size() != 0) {
+            const std::string highlight = "<span style=\"background-color:" + color + "\">"
+                                          + std::string(1, separator) + "</span>";
+            formated_line = temp_string_vec.at(0);
+            for (size_t j = 1; j < temp_string_vec.size(); ++j) {
+                formated_line += highlight;
+                formated_line += temp_string_vec.at(j);
+            }
+        }
+    }
+
+    if (formated_line == "")
+        return "<hr>";
+    return "<div><font color=\"" + color + "\">" + formated_line + "</font></div>";
+}
+
 } // namespace DataImportUtils
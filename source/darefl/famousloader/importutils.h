@@ -14,6 +14,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace DataImportUtils
@@ -21,16 +22,35 @@ namespace DataImportUtils
 // Convention
 using string_data = std::vector<std::vector<std::string>>;
 using header_map = std::map<std::string, int>;
+using numeric_data = std::vector<std::vector<double>>;
 
 // global constants
 enum InfoTypes { Name, Type, Unit, Multiplier, Header };
 const std::vector<std::string> InfoNames{"Name", "Type", "Unit", "Multiplier", "Header"};
-const std::vector<std::string> Types{"Intensity", "Axis", "Ignore"};
+const std::vector<std::string> Types{"Intensity", "Axis", "Intensity error", "Axis resolution",
+                                     "Ignore"};
 const std::vector<std::string> Units{"a.u.", "counts", "bin", "rad", "deg", "mm", "1/nm"};
 
 //! Helper method to split
 std::vector<std::string> split(const std::string& s, char delim);
 
+//! Call the function for each non-empty token of the line, without copying
+template <typename F> void forEachToken(std::string_view line, char delim, F&& func)
+{
+    size_t begin = 0;
+    while (begin < line.size()) {
+        size_t end = line.find(delim, begin);
+        if (end == std::string_view::npos)
+            end = line.size();
+        if (end > begin)
+            func(line.substr(begin, end - begin));
+        begin = end + 1;
+    }
+}
+
+//! Convert the string to double, nan if it doesn't start with a number (same as std::stod)
+double toDouble(std::string_view input);
+
 //! Helper method to clean a string vector
 void clean(std::vector<std::string>& input);
 
@@ -64,6 +84,9 @@ void eraseSubStrings(std::string& main_string, const std::vector<std::string>& s
 //! Erase All occurences of substring
 void eraseAllSubString(std::string& main_string, const std::string& earase);
 
+//! Format a line of the preview as html, highlighting the separators in the given color
+std::string formatPreviewLine(std::string_view line, char separator, const std::string& color);
+
 } // namespace DataImportUtils
 
 #endif // DAREFL_FAMOUSLOADER_IMPORTUTILS_H
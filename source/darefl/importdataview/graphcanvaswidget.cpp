@@ -10,22 +10,40 @@
 #include <QVBoxLayout>
 #include <darefl/importdataview/graphcanvaswidget.h>
 #include <darefl/model/experimentaldataitems.h>
+#include <darefl/model/experimentaldatamodel.h>
+#include <darefl/model/levelofdetailcontroller.h>
 #include <mvvm/plotting/graphcanvas.h>
 
 GraphCanvasWidget::GraphCanvasWidget(QWidget* parent)
-    : QWidget(parent), m_graphCanvas(new ModelView::GraphCanvas)
+    : QWidget(parent), m_graphCanvas(new ModelView::GraphCanvas),
+      m_lodController(
+          std::make_unique<LevelOfDetailController>([this]() { return m_graphCanvas->width(); }))
 {
     auto layout = new QVBoxLayout(this);
     layout->addWidget(m_graphCanvas);
     layout->setContentsMargins(0, 5, 5, 5);
 }
 
+GraphCanvasWidget::~GraphCanvasWidget() = default;
+
 void GraphCanvasWidget::setItem(CanvasItem* canvas_item)
 {
+    m_lodController->setDataModel(
+        canvas_item ? dynamic_cast<ExperimentalDataModel*>(canvas_item->model()) : nullptr);
+    m_lodController->setViewport(canvas_item);
     m_graphCanvas->setItem(canvas_item);
 }
 
 void GraphCanvasWidget::updateViewport()
 {
+    m_lodController->resetRange();
     m_graphCanvas->update_viewport();
 }
+
+//! Decimated data could be changed by other canvas showing the same graphs.
+
+void GraphCanvasWidget::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    m_lodController->update();
+}
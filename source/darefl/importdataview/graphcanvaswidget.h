@@ -11,6 +11,7 @@
 #define DAREFL_IMPORTDATAVIEW_GRAPHCANVASWIDGET_H
 
 #include <QWidget>
+#include <memory>
 
 namespace ModelView
 {
@@ -18,22 +19,29 @@ class GraphCanvas;
 }
 
 class CanvasItem;
+class LevelOfDetailController;
 
 //! Widget to show canvas with graph collection.
-//! Occupies the right part of ImportDataEditor.
+//! Occupies the right part of ImportDataEditor. Decimated data of the canvas graphs is recalculated
+//! for the visible x-range on every zoom and pan.
 
 class GraphCanvasWidget : public QWidget
 {
     Q_OBJECT
 public:
     GraphCanvasWidget(QWidget* parent = nullptr);
+    ~GraphCanvasWidget() override;
 
     void setItem(CanvasItem* canvas_item);
 
     void updateViewport();
 
+protected:
+    void showEvent(QShowEvent* event) override;
+
 private:
     ModelView::GraphCanvas* m_graphCanvas{nullptr};
+    std::unique_ptr<LevelOfDetailController> m_lodController;
 };
 
 #endif // DAREFL_IMPORTDATAVIEW_GRAPHCANVASWIDGET_H
@@ -77,7 +77,9 @@ void ImportDataEditor::selectionChanged()
 
     auto items = selection_model->selectedItems();
     items.erase(std::remove(begin(items), end(items), nullptr), end(items));
-    setMergeEnabled((items.size() > 1) ? (p_model->checkAllGroup(items)) : (false));
+    setMergeEnabled((items.size() > 1)
+                        ? (p_model->checkAllGroup(items) || p_model->checkAllGraph(items))
+                        : (false));
 
     if (items.size() == 0)
         return;
@@ -133,13 +135,13 @@ void ImportDataEditor::onImportDialogAccept(DataImportLogic::ImportOutput import
 {
     CanvasContainerItem* canvas_container = p_model->canvasContainer();
     CanvasItem* canvas = dynamic_cast<CanvasItem*>(p_model->findItem(import_output.target()));
+    std::vector<RealDataStruct> data_structs;
     for (auto& path : import_output.keys()) {
         auto parsed_file_output = import_output[path];
-        for (int i = 0; i < parsed_file_output->dataCount(); ++i) {
-            auto data_struct = convertToRealDataStruct(path, parsed_file_output, i);
-            canvas = p_model->addDataToCollection(data_struct, canvas_container, canvas);
-        }
+        for (int i = 0; i < parsed_file_output->dataCount(); ++i)
+            data_structs.push_back(convertToRealDataStruct(path, parsed_file_output, i));
     }
+    canvas = p_model->addDataToCollection(std::move(data_structs), canvas_container, canvas);
     selectionModel()->selectItem(canvas);
 }
 
@@ -157,10 +159,12 @@ ImportDataEditor::convertToRealDataStruct(const std::string& path,
     data_struct.axis = import_output->axis();
     data_struct.axis_name = import_output->axisName();
     data_struct.axis_unit = import_output->axisUnit();
+    data_struct.axis_resolution = import_output->axisResolution();
 
     data_struct.data = import_output->data(column);
     data_struct.data_name = import_output->dataName(column);
     data_struct.data_unit = import_output->dataUnit(column);
+    data_struct.data_errors = import_output->dataErrors(column);
 
     return data_struct;
 }
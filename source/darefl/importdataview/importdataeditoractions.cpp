@@ -37,13 +37,13 @@ void ImportDataEditorActions::onAddDataGroup()
     m_dataModel->addDataToCollection(RealDataStruct(), data_node, nullptr);
 }
 
-//! Merge the selected actions
+//! Merge the selected canvas, or stitch the selected graphs of one canvas
 
 void ImportDataEditorActions::onMergeDataGroups()
 {
     auto items = m_selectionModel->selectedItems();
     items.erase(std::remove(begin(items), end(items), nullptr), end(items));
-    if (!m_dataModel->checkAllGroup(items))
+    if (!m_dataModel->checkAllGroup(items) && !m_dataModel->checkAllGraph(items))
         return;
 
     m_dataModel->mergeItems(items);
@@ -37,7 +37,8 @@ ImportDataEditorToolBar::ImportDataEditorToolBar(ImportDataEditorActions* editor
 
     auto merge_group_action = new QAction("Merge", this);
     merge_group_action->setToolTip("Merge several selected canvas into one.\n"
-                                   "All graphs will appear on a single canvas.");
+                                   "All graphs will appear on a single canvas.\n"
+                                   "Graphs selected on one canvas are stitched into a new graph.");
     merge_group_action->setIcon(QIcon(":/icons/set-merge.svg"));
     merge_group_action->setObjectName("merge_group_action");
     connect(merge_group_action, &QAction::triggered,
@@ -48,7 +48,14 @@ void ActionManager::setRecentProjectsList(const QStringList& projects)
     m_recentProjects = projects;
 }
 
-//! Creates application-wise actions to create, open, save, and save-as projects.
+void ActionManager::setUndoRedoEnabled(bool can_undo, bool can_redo)
+{
+    m_undoAction->setEnabled(can_undo);
+    m_redoAction->setEnabled(can_redo);
+}
+
+//! Creates application-wise actions to create, open, save, and save-as projects, and to undo
+//! and redo edits.
 
 void ActionManager::createActions()
 {
@@ -80,6 +87,16 @@ void ActionManager::createActions()
     m_exitAction->setShortcuts(QKeySequence::Quit);
     m_exitAction->setStatusTip("Exit the application");
     connect(m_exitAction, &QAction::triggered, m_mainWindow, &QMainWindow::close);
+
+    m_undoAction = new QAction("&Undo", this);
+    m_undoAction->setShortcuts(QKeySequence::Undo);
+    m_undoAction->setStatusTip("Undo the last edit of layers and materials");
+    connect(m_undoAction, &QAction::triggered, this, &ActionManager::undoRequest);
+
+    m_redoAction = new QAction("&Redo", this);
+    m_redoAction->setShortcuts(QKeySequence::Redo);
+    m_redoAction->setStatusTip("Redo the last undone edit of layers and materials");
+    connect(m_redoAction, &QAction::triggered, this, &ActionManager::redoRequest);
 }
 
 //! Equips menu with actions.
@@ -98,4 +115,8 @@ void ActionManager::setupMenus(QMenuBar* menubar)
 
     fileMenu->addSeparator();
     fileMenu->addAction(m_exitAction);
+
+    auto editMenu = menubar->addMenu("&Edit");
+    editMenu->addAction(m_undoAction);
+    editMenu->addAction(m_redoAction);
 }
@@ -18,7 +18,8 @@ class QMenuBar;
 class QMenu;
 
 //! Actions for MainWindow. Equips toolbar and menubar with actions to create, open, save,
-//! and save-as projects. It doesn't have logic and simply forwards requests further.
+//! and save-as projects, and to undo and redo edits. It doesn't have logic and simply forwards
+//! requests further.
 
 class ActionManager : public QObject
 {
@@ -32,9 +33,12 @@ signals:
     void saveCurrentProjectRequest();
     void saveProjectAsRequest();
     void clearResentProjectListRequest();
+    void undoRequest();
+    void redoRequest();
 
 public slots:
     void setRecentProjectsList(const QStringList& projects);
+    void setUndoRedoEnabled(bool can_undo, bool can_redo);
 
 private slots:
     void aboutToShowFileMenu();
@@ -50,6 +54,8 @@ private:
     QAction* m_saveCurrentProjectAction{nullptr};
     QAction* m_saveProjectAsAction{nullptr};
     QAction* m_exitAction{nullptr};
+    QAction* m_undoAction{nullptr};
+    QAction* m_redoAction{nullptr};
 
     QMenu* m_recentProjectMenu{nullptr};
 
@@ -20,6 +20,7 @@
 #include <darefl/mainwindow/simulationview_v2.h>
 #include <darefl/mainwindow/simulationwidget/simulationwidget.h>
 #include <darefl/model/applicationmodels.h>
+#include <darefl/model/edithistory.h>
 #include <darefl/settingsview/settingsview.h>
 #include <darefl/welcomeview/welcomeview.h>
 
@@ -110,6 +111,18 @@ void MainWindow::init_connections()
     connect(m_welcomeView, &WelcomeView::recentProjectsListModified, m_actionManager,
             &ActionManager::setRecentProjectsList);
 
+    // undo and redo of layer and material edits
+    connect(m_actionManager, &ActionManager::undoRequest,
+            [this]() { m_models->editHistory()->undo(); });
+    connect(m_actionManager, &ActionManager::redoRequest,
+            [this]() { m_models->editHistory()->redo(); });
+    auto update_undo_redo = [this]() {
+        auto history = m_models->editHistory();
+        m_actionManager->setUndoRedoEnabled(history->canUndo(), history->canRedo());
+    };
+    m_models->editHistory()->setOnChange(update_undo_redo);
+    update_undo_redo();
+
     m_welcomeView->updateNames();
 }
 
@@ -8,6 +8,7 @@
 // ************************************************************************** //
 
 #include <darefl/model/applicationmodels.h>
+#include <darefl/model/edithistory.h>
 #include <darefl/model/experimentaldatacontroller.h>
 #include <darefl/model/experimentaldatamodel.h>
 #include <darefl/model/instrumentmodel.h>
@@ -33,6 +34,7 @@ struct ApplicationModels::ApplicationModelsImpl {
     std::unique_ptr<InstrumentModel> m_instrument_model;
     std::unique_ptr<MaterialPropertyController> m_material_controller;
     std::unique_ptr<ExperimentalDataController> m_data_controller;
+    std::unique_ptr<EditHistory> m_edit_history;
     std::shared_ptr<ItemPool> item_pool;
 
     ApplicationModelsImpl()
@@ -50,6 +52,9 @@ struct ApplicationModels::ApplicationModelsImpl {
                                                                          m_instrument_model.get());
         m_sample_model->create_default_multilayer();
         update_material_properties();
+        m_edit_history =
+            std::make_unique<EditHistory>(std::vector<SessionModel*>{m_material_model.get(),
+                                                                     m_sample_model.get()});
     }
 
     //! Runs through all layers and assign materials.
@@ -116,6 +121,13 @@ InstrumentModel* ApplicationModels::instrumentModel()
     return p_impl->m_instrument_model.get();
 }
 
+//! Returns undo/redo history of layer and material edits.
+
+EditHistory* ApplicationModels::editHistory()
+{
+    return p_impl->m_edit_history.get();
+}
+
 std::vector<SessionModel*> ApplicationModels::persistent_models() const
 {
     return p_impl->persistent_models();
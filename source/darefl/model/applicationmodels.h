@@ -25,6 +25,7 @@ class SLDElementController;
 class JobModel;
 class ExperimentalDataModel;
 class InstrumentModel;
+class EditHistory;
 
 //!  Main class to holds all models of GUI session.
 
@@ -40,6 +41,7 @@ public:
     JobModel* jobModel();
     ExperimentalDataModel* experimentalDataModel();
     InstrumentModel* instrumentModel();
+    EditHistory* editHistory();
 
     std::vector<ModelView::SessionModel*> persistent_models() const override;
 
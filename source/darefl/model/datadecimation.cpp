@@ -0,0 +1,69 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include <algorithm>
+#include <cmath>
+#include <darefl/model/datadecimation.h>
+#include <numeric>
+
+std::vector<size_t> Utils::MinMaxDecimation(const std::vector<double>& xvalues,
+                                            const std::vector<double>& yvalues, double xmin,
+                                            double xmax, int n_columns)
+{
+    const size_t size = std::min(xvalues.size(), yvalues.size());
+    auto begin = static_cast<size_t>(
+        std::lower_bound(xvalues.begin(), xvalues.begin() + size, xmin) - xvalues.begin());
+    auto end = static_cast<size_t>(
+        std::upper_bound(xvalues.begin(), xvalues.begin() + size, xmax) - xvalues.begin());
+    if (begin > 0)
+        --begin;
+    if (end < size)
+        ++end;
+    if (begin >= end)
+        return {};
+
+    // the range is limited to the data to handle infinite boundaries
+    xmin = std::max(xmin, xvalues[begin]);
+    xmax = std::min(xmax, xvalues[end - 1]);
+
+    std::vector<size_t> result;
+    if (n_columns <= 0 || !(xmax > xmin) || end - begin <= 4 * static_cast<size_t>(n_columns)) {
+        result.resize(end - begin);
+        std::iota(result.begin(), result.end(), begin);
+        return result;
+    }
+
+    // points outside of the range get columns -1 and n_columns
+    const double column_width = (xmax - xmin) / n_columns;
+    auto column = [&](size_t index) {
+        const double position = std::floor((xvalues[index] - xmin) / column_width);
+        return static_cast<int>(std::clamp(position, -1.0, static_cast<double>(n_columns)));
+    };
+
+    size_t index = begin;
+    while (index < end) {
+        const int current_column = column(index);
+        const size_t first = index;
+        size_t imin = index, imax = index;
+        for (; index < end && column(index) == current_column; ++index) {
+            if (yvalues[index] < yvalues[imin])
+                imin = index;
+            if (yvalues[index] > yvalues[imax])
+                imax = index;
+        }
+        const size_t last = index - 1;
+
+        size_t points[] = {first, std::min(imin, imax), std::max(imin, imax), last};
+        for (auto point : points)
+            if (result.empty() || result.back() < point)
+                result.push_back(point);
+    }
+
+    return result;
+}
@@ -0,0 +1,30 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#ifndef DAREFL_MODEL_DATADECIMATION_H
+#define DAREFL_MODEL_DATADECIMATION_H
+
+#include <cstddef>
+#include <vector>
+
+namespace Utils
+{
+
+//! Returns indices of points representing the curve within [xmin, xmax] on a plot with given
+//! number of columns. For every column the first, the last, the minimum and the maximum points
+//! are kept, so the plotted envelope looks the same as for the full curve. All points are
+//! returned if the range contains only a few of them. Nearest points outside of the range are
+//! included to keep lines continuous. Axis values are expected to be sorted.
+std::vector<size_t> MinMaxDecimation(const std::vector<double>& xvalues,
+                                     const std::vector<double>& yvalues, double xmin, double xmax,
+                                     int n_columns);
+
+} // namespace Utils
+
+#endif // DAREFL_MODEL_DATADECIMATION_H
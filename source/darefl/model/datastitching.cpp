@@ -0,0 +1,194 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include <algorithm>
+#include <cmath>
+#include <darefl/model/datastitching.h>
+#include <numeric>
+
+using namespace DataStitching;
+
+namespace
+{
+
+double error(const Curve& curve, size_t index)
+{
+    return curve.errors.empty() ? std::abs(curve.values[index]) : curve.errors[index];
+}
+
+//! Returns statistical weight of the point, zero for points with unknown uncertainty.
+double weight(double error)
+{
+    return error > 0.0 ? 1.0 / (error * error) : 0.0;
+}
+
+//! Merges two sorted curves into one sorted curve.
+Curve merge(const Curve& lhs, const Curve& rhs)
+{
+    Curve result;
+    const size_t size = lhs.axis.size() + rhs.axis.size();
+    result.axis.reserve(size);
+    result.values.reserve(size);
+    const bool has_errors = !lhs.errors.empty() && !rhs.errors.empty();
+    if (has_errors)
+        result.errors.reserve(size);
+
+    size_t i = 0, j = 0;
+    while (i < lhs.axis.size() || j < rhs.axis.size()) {
+        const bool take_lhs =
+            j == rhs.axis.size() || (i < lhs.axis.size() && lhs.axis[i] <= rhs.axis[j]);
+        const auto& curve = take_lhs ? lhs : rhs;
+        auto& index = take_lhs ? i : j;
+        result.axis.push_back(curve.axis[index]);
+        result.values.push_back(curve.values[index]);
+        if (has_errors)
+            result.errors.push_back(curve.errors[index]);
+        ++index;
+    }
+    return result;
+}
+
+} // namespace
+
+Curve DataStitching::Sorted(Curve curve)
+{
+    if (std::is_sorted(curve.axis.begin(), curve.axis.end()))
+        return curve;
+
+    std::vector<size_t> order(curve.axis.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&curve](auto lhs, auto rhs) { return curve.axis[lhs] < curve.axis[rhs]; });
+
+    Curve result;
+    for (auto index : order) {
+        result.axis.push_back(curve.axis[index]);
+        result.values.push_back(curve.values[index]);
+        if (!curve.errors.empty())
+            result.errors.push_back(curve.errors[index]);
+    }
+    return result;
+}
+
+double DataStitching::ScaleFactor(const Curve& reference, const Curve& curve)
+{
+    if (reference.axis.size() < 2)
+        return 1.0;
+
+    // minimizes sum of w * (reference - scale * value)^2
+    double sum_rv{0.0}, sum_vv{0.0};
+    size_t i = 0;
+    for (size_t j = 0; j < curve.axis.size(); ++j) {
+        const double q = curve.axis[j];
+        if (q < reference.axis.front())
+            continue;
+        if (q > reference.axis.back())
+            break;
+        while (i + 2 < reference.axis.size() && reference.axis[i + 1] < q)
+            ++i;
+
+        const double q0 = reference.axis[i], q1 = reference.axis[i + 1];
+        const double t = q1 > q0 ? (q - q0) / (q1 - q0) : 0.0;
+        const double ref_value = (1.0 - t) * reference.values[i] + t * reference.values[i + 1];
+        const double ref_error = (1.0 - t) * error(reference, i) + t * error(reference, i + 1);
+        const double curve_error = error(curve, j);
+
+        const double w = weight(std::sqrt(ref_error * ref_error + curve_error * curve_error));
+        sum_rv += w * ref_value * curve.values[j];
+        sum_vv += w * curve.values[j] * curve.values[j];
+    }
+
+    return sum_vv > 0.0 && sum_rv > 0.0 ? sum_rv / sum_vv : 1.0;
+}
+
+std::vector<double> DataStitching::BinEdges(double qmin, double qmax, int n_bins)
+{
+    n_bins = std::max(n_bins, 1);
+    std::vector<double> result(static_cast<size_t>(n_bins) + 1);
+    const bool log_scale = qmin > 0.0;
+    const double start = log_scale ? std::log(qmin) : qmin;
+    const double stop = log_scale ? std::log(qmax) : qmax;
+    for (size_t i = 0; i < result.size(); ++i) {
+        const double value = start + (stop - start) * i / n_bins;
+        result[i] = log_scale ? std::exp(value) : value;
+    }
+    // guarantees that the extreme points fall into the grid despite rounding
+    result.front() = qmin;
+    result.back() = qmax;
+    return result;
+}
+
+Curve DataStitching::Rebin(const Curve& curve, const std::vector<double>& edges)
+{
+    Curve result;
+    if (edges.size() < 2)
+        return result;
+
+    const bool has_errors = !curve.errors.empty();
+    size_t index = 0;
+    // skips points below the grid
+    while (index < curve.axis.size() && curve.axis[index] < edges.front())
+        ++index;
+
+    for (size_t bin = 0; bin + 1 < edges.size() && index < curve.axis.size(); ++bin) {
+        // the last bin includes its upper edge
+        const bool is_last = bin + 2 == edges.size();
+        auto in_bin = [&](double q) {
+            return q < edges[bin + 1] || (is_last && q == edges.back());
+        };
+
+        double sum_w{0.0}, sum_wq{0.0}, sum_wv{0.0}, sum_q{0.0}, sum_v{0.0};
+        size_t count{0};
+        for (; index < curve.axis.size() && in_bin(curve.axis[index]); ++index) {
+            const double w = weight(error(curve, index));
+            sum_w += w;
+            sum_wq += w * curve.axis[index];
+            sum_wv += w * curve.values[index];
+            sum_q += curve.axis[index];
+            sum_v += curve.values[index];
+            ++count;
+        }
+        if (count == 0)
+            continue;
+
+        // points with unknown uncertainty are averaged plainly
+        result.axis.push_back(sum_w > 0.0 ? sum_wq / sum_w : sum_q / count);
+        result.values.push_back(sum_w > 0.0 ? sum_wv / sum_w : sum_v / count);
+        if (has_errors)
+            result.errors.push_back(sum_w > 0.0 ? 1.0 / std::sqrt(sum_w) : 0.0);
+    }
+    return result;
+}
+
+Curve DataStitching::Stitch(std::vector<Curve> curves, int n_bins)
+{
+    curves.erase(std::remove_if(curves.begin(), curves.end(),
+                                [](const auto& curve) { return curve.axis.empty(); }),
+                 curves.end());
+    if (curves.empty())
+        return {};
+
+    for (auto& curve : curves)
+        curve = Sorted(std::move(curve));
+    std::sort(curves.begin(), curves.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.axis.front() < rhs.axis.front(); });
+
+    Curve result = std::move(curves.front());
+    for (size_t i = 1; i < curves.size(); ++i) {
+        auto& curve = curves[i];
+        const double scale = ScaleFactor(result, curve);
+        for (auto& value : curve.values)
+            value *= scale;
+        for (auto& error : curve.errors)
+            error *= scale;
+        result = merge(result, curve);
+    }
+
+    return Rebin(result, BinEdges(result.axis.front(), result.axis.back(), n_bins));
+}
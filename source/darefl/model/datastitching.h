@@ -0,0 +1,50 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#ifndef DAREFL_MODEL_DATASTITCHING_H
+#define DAREFL_MODEL_DATASTITCHING_H
+
+#include <vector>
+
+//! Stitching of reflectivity curves measured in overlapping q-ranges into a single curve.
+//! All operations are sweeps over q-sorted arrays.
+
+namespace DataStitching
+{
+
+//! Reflectivity curve. Empty errors mean that all points have the same relative uncertainty.
+struct Curve {
+    std::vector<double> axis;
+    std::vector<double> values;
+    std::vector<double> errors;
+};
+
+//! Returns the curve with points sorted along the axis.
+Curve Sorted(Curve curve);
+
+//! Returns the factor to scale the curve with to match the reference curve in the overlapping
+//! q-range, found by error-weighted least squares. Reference values are linearly interpolated.
+//! Returns one if curves don't overlap. Both curves are expected to be sorted.
+double ScaleFactor(const Curve& reference, const Curve& curve);
+
+//! Returns edges of `n_bins` bins covering [qmin, qmax]. Bins are equidistant in log scale
+//! for positive q, as the resolution of reflectometers is relative.
+std::vector<double> BinEdges(double qmin, double qmax, int n_bins);
+
+//! Averages points of the sorted curve falling into the same bin using error weights.
+//! Empty bins are skipped.
+Curve Rebin(const Curve& curve, const std::vector<double>& edges);
+
+//! Scales every curve to the previous ones, starting from the curve with the lowest q,
+//! and rebins the union onto the common grid of `n_bins` bins.
+Curve Stitch(std::vector<Curve> curves, int n_bins);
+
+} // namespace DataStitching
+
+#endif // DAREFL_MODEL_DATASTITCHING_H
@@ -0,0 +1,202 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include <QUndoStack>
+#include <darefl/model/edithistory.h>
+#include <mvvm/commands/undostack.h>
+#include <mvvm/interfaces/undostackinterface.h>
+#include <mvvm/model/sessionmodel.h>
+#include <mvvm/signals/modellistener.h>
+
+using namespace ModelView;
+
+EditHistory::EditHistory(std::vector<SessionModel*> models, int max_commands)
+    : m_models(std::move(models)), m_max_commands(static_cast<size_t>(max_commands))
+{
+    for (auto model : m_models) {
+        // the limit can only be set on the empty stack, the default content isn't undoable
+        model->undoStack()->clear();
+        model->undoStack()->setUndoLimit(max_commands);
+        m_top[model] = nullptr;
+        subscribe(model);
+    }
+}
+
+EditHistory::~EditHistory() = default;
+
+bool EditHistory::canUndo() const
+{
+    return !m_undo.empty();
+}
+
+bool EditHistory::canRedo() const
+{
+    return !m_redo.empty();
+}
+
+void EditHistory::undo()
+{
+    replay(/*is_undo*/ true);
+}
+
+void EditHistory::redo()
+{
+    replay(/*is_undo*/ false);
+}
+
+void EditHistory::clear()
+{
+    for (auto model : m_models) {
+        model->undoStack()->clear();
+        m_top[model] = nullptr;
+    }
+    m_undo.clear();
+    m_redo.clear();
+    notify();
+}
+
+//! All changes until the matching endMacro() are recorded as a single step. Every model records
+//! its changes in a macro of its own undo stack.
+
+void EditHistory::beginMacro()
+{
+    if (m_macro_depth++ > 0)
+        return;
+
+    for (auto model : m_models) {
+        model->undoStack()->beginMacro("edit");
+        m_changed_in_macro[model] = false;
+    }
+    // undo stacks drop undone commands on the start of the macro
+    m_redo.clear();
+    notify();
+}
+
+//! Ends the macro. Macros of models which didn't change are stepped back, so that an empty step
+//! doesn't appear in the history.
+
+void EditHistory::endMacro()
+{
+    if (m_macro_depth == 0 || --m_macro_depth > 0)
+        return;
+
+    std::vector<SessionModel*> step;
+    for (auto model : m_models) {
+        model->undoStack()->endMacro();
+        if (m_changed_in_macro[model]) {
+            m_top[model] = top_command(model);
+            step.push_back(model);
+        } else if (top_command(model) != m_top[model]) {
+            m_replaying = true;
+            model->undoStack()->undo();
+            m_replaying = false;
+        }
+    }
+    if (!step.empty())
+        push(std::move(step));
+    notify();
+}
+
+//! Sets the callback which is called whenever steps are added or applied, e.g. to update the state
+//! of undo and redo actions.
+
+void EditHistory::setOnChange(callback_t callback)
+{
+    m_on_change = std::move(callback);
+}
+
+void EditHistory::subscribe(SessionModel* model)
+{
+    auto listener = std::make_unique<ModelListener<SessionModel>>(model);
+    listener->setOnDataChange([this, model](auto, auto) { on_change(model); });
+    listener->setOnItemInserted([this, model](auto, auto) { on_change(model); });
+    listener->setOnItemRemoved([this, model](auto, auto) { on_change(model); });
+    listener->setOnModelReset([this](auto) { clear(); });
+    m_listeners.push_back(std::move(listener));
+}
+
+//! Records a new step if the change of the model came with a new command on its undo stack.
+//! Changes without commands (direct updates, the second half of a move) are skipped.
+
+void EditHistory::on_change(SessionModel* model)
+{
+    if (m_replaying)
+        return;
+
+    if (m_macro_depth > 0) {
+        m_changed_in_macro[model] = true;
+        return;
+    }
+
+    auto command = top_command(model);
+    if (command == m_top[model])
+        return;
+
+    m_top[model] = command;
+    push({model});
+    notify();
+}
+
+//! Undoes the last applied step, or redoes the last undone one. Commands of a step are undone in
+//! reverse order. Steps whose commands were dropped by the limit of undo stacks are skipped.
+
+void EditHistory::replay(bool is_undo)
+{
+    auto& from = is_undo ? m_undo : m_redo;
+    auto& to = is_undo ? m_redo : m_undo;
+
+    while (!from.empty()) {
+        auto step = std::move(from.back());
+        from.pop_back();
+
+        bool applied{false};
+        m_replaying = true;
+        for (size_t i = 0; i < step.size(); ++i) {
+            auto model = is_undo ? step[step.size() - 1 - i] : step[i];
+            auto stack = model->undoStack();
+            if (is_undo ? stack->canUndo() : stack->canRedo()) {
+                is_undo ? stack->undo() : stack->redo();
+                m_top[model] = top_command(model);
+                applied = true;
+            }
+        }
+        m_replaying = false;
+
+        if (applied) {
+            to.push_back(std::move(step));
+            break;
+        }
+    }
+    notify();
+}
+
+//! Returns the last applied command of the model's undo stack.
+
+const QUndoCommand* EditHistory::top_command(SessionModel* model) const
+{
+    auto stack = UndoStack::qtUndoStack(model->undoStack());
+    return stack && stack->index() > 0 ? stack->command(stack->index() - 1) : nullptr;
+}
+
+//! Adds the step to the history. Undone steps can't be redone after that. The oldest steps are
+//! dropped, as their commands are dropped by undo stacks.
+
+void EditHistory::push(std::vector<SessionModel*> step)
+{
+    m_redo.clear();
+    m_undo.push_back(std::move(step));
+    while (m_undo.size() > m_max_commands)
+        m_undo.pop_front();
+}
+
+void EditHistory::notify()
+{
+    if (m_on_change)
+        m_on_change();
+}
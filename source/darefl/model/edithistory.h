@@ -0,0 +1,72 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#ifndef DAREFL_MODEL_EDITHISTORY_H
+#define DAREFL_MODEL_EDITHISTORY_H
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+class QUndoCommand;
+
+namespace ModelView
+{
+class SessionModel;
+template <typename T> class ModelListener;
+} // namespace ModelView
+
+//! Common undo/redo of edits in a set of models with enabled undo stacks.
+//! Commands are kept by the undo stacks of the models, which are limited to the given number of
+//! commands. The history only remembers which models the commands of every step belong to, so
+//! that undo and redo follow the order of edits across models. Changes between beginMacro() and
+//! endMacro(), e.g. while dragging a handle in the SLD editor, are undone in one step.
+
+class EditHistory
+{
+public:
+    using callback_t = std::function<void()>;
+
+    EditHistory(std::vector<ModelView::SessionModel*> models, int max_commands = 1000);
+    ~EditHistory();
+
+    bool canUndo() const;
+    bool canRedo() const;
+    void undo();
+    void redo();
+    void clear();
+
+    void beginMacro();
+    void endMacro();
+
+    void setOnChange(callback_t callback);
+
+private:
+    void subscribe(ModelView::SessionModel* model);
+    void on_change(ModelView::SessionModel* model);
+    void replay(bool is_undo);
+    const QUndoCommand* top_command(ModelView::SessionModel* model) const;
+    void push(std::vector<ModelView::SessionModel*> step);
+    void notify();
+
+    std::vector<ModelView::SessionModel*> m_models;
+    std::vector<std::unique_ptr<ModelView::ModelListener<ModelView::SessionModel>>> m_listeners;
+    std::map<ModelView::SessionModel*, const QUndoCommand*> m_top; //! last known commands
+    std::map<ModelView::SessionModel*, bool> m_changed_in_macro;
+    std::deque<std::vector<ModelView::SessionModel*>> m_undo; //! applied steps, oldest first
+    std::deque<std::vector<ModelView::SessionModel*>> m_redo; //! undone steps, last undone last
+    size_t m_max_commands{0};
+    int m_macro_depth{0};
+    bool m_replaying{false};
+    callback_t m_on_change;
+};
+
+#endif // DAREFL_MODEL_EDITHISTORY_H
@@ -22,10 +22,12 @@ struct RealDataStruct {
     std::vector<double> axis;
     std::string axis_name;
     std::string axis_unit;
+    std::vector<double> axis_resolution; //! standard deviation of axis values, empty if unknown
 
     std::vector<double> data;
     std::string data_name;
     std::string data_unit;
+    std::vector<double> data_errors; //! standard deviation of data values, empty if unknown
 };
 
 #endif // DAREFL_MODEL_EXPERIMENTALDATA_TYPES_H
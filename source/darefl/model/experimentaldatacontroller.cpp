@@ -14,30 +14,150 @@
 #include <darefl/model/instrumentmodel.h>
 #include <darefl/model/modelutils.h>
 #include <mvvm/model/externalproperty.h>
+#include <mvvm/model/itemutils.h>
 #include <mvvm/model/modelutils.h>
+#include <mvvm/standarditems/graphitem.h>
+
+namespace
+{
+
+//! Returns all graphs in the branch of given item, including the item itself.
+std::vector<ModelView::GraphItem*> graphs_in_branch(ModelView::SessionItem* item)
+{
+    std::vector<ModelView::GraphItem*> result;
+    ModelView::Utils::iterate(item, [&result](auto child) {
+        if (auto graph = dynamic_cast<ModelView::GraphItem*>(child))
+            result.push_back(graph);
+    });
+    return result;
+}
+
+} // namespace
 
 ExperimentalDataController::ExperimentalDataController(ExperimentalDataModel* data_model,
                                                        InstrumentModel* instrument_model)
     : ModelListener(data_model), m_instrument_model(instrument_model)
 {
-    setOnDataChange([this](auto, auto) { update_all(); });
-    setOnItemInserted([this](auto, auto) { update_all(); });
-    setOnItemRemoved([this](auto, auto) { update_all(); });
+    setOnDataChange([this](auto item, auto) {
+        if (!skip_batch())
+            update_graphs(item);
+    });
+    setOnItemInserted([this](auto item, auto tagrow) {
+        if (!skip_batch())
+            update_graphs(item->getItem(tagrow.tag, tagrow.row));
+    });
+    setOnAboutToRemoveItem([this](auto item, auto tagrow) {
+        if (!skip_batch())
+            on_about_to_remove(item->getItem(tagrow.tag, tagrow.row));
+    });
+    setOnItemRemoved([this](auto, auto) {
+        if (!skip_batch())
+            on_removed();
+    });
     setOnModelReset([this](auto) { update_all(); });
 
     update_all();
 }
 
-//! Updates all material properties in LayerItems to get new material colors and labels.
+//! Returns true if the notification belongs to a batch insertion and should be skipped.
+//! The index is rebuilt on the first notification after the batch, which the model reports
+//! as a single consolidated change.
+
+bool ExperimentalDataController::skip_batch()
+{
+    if (model()->isBatchInProgress()) {
+        m_index_outdated = true;
+        return true;
+    }
+
+    if (m_index_outdated)
+        update_all();
+
+    return false;
+}
+
+//! Rebuilds the index of graph properties and updates links of all scans.
 
 void ExperimentalDataController::update_all()
 {
+    m_properties.clear();
+    for (const auto& property : Utils::CreateGraphProperties(model()))
+        m_properties.emplace(property.identifier(), property);
+    m_removed_ids.clear();
+    m_index_outdated = false;
+
+    for (auto scan : ModelView::Utils::FindItems<ExperimentalScanItem>(m_instrument_model)) {
+        auto property =
+            scan->property<ModelView::ExternalProperty>(ExperimentalScanItem::P_IMPORTED_DATA);
+        auto it = m_properties.find(property.identifier());
+        auto updated = it == m_properties.end() ? ModelView::ExternalProperty::undefined()
+                                                : it->second;
+        if (property != updated)
+            scan->setProperty(ExperimentalScanItem::P_IMPORTED_DATA, updated);
+    }
+}
+
+//! Updates index entries of graphs affected by the change of given item. The graph property
+//! depends on the graph itself, its color and the name of its canvas.
+
+void ExperimentalDataController::update_graphs(ModelView::SessionItem* item)
+{
+    if (!item)
+        return;
+
+    std::vector<ModelView::GraphItem*> graphs;
+    if (auto graph = dynamic_cast<ModelView::GraphItem*>(item->parent()))
+        graphs.push_back(graph);
+    else
+        graphs = graphs_in_branch(item);
+
+    std::set<std::string> changed_ids;
+    for (auto graph : graphs) {
+        auto property = Utils::CreateProperty(graph);
+        auto& entry = m_properties[property.identifier()];
+        if (entry != property) {
+            entry = property;
+            changed_ids.insert(property.identifier());
+        }
+    }
+    update_scans(changed_ids);
+}
+
+//! Updates links of scans referring to given graph identifiers.
+
+void ExperimentalDataController::update_scans(const std::set<std::string>& ids)
+{
+    if (ids.empty())
+        return;
+
     for (auto scan : ModelView::Utils::FindItems<ExperimentalScanItem>(m_instrument_model)) {
         auto property =
             scan->property<ModelView::ExternalProperty>(ExperimentalScanItem::P_IMPORTED_DATA);
-        auto updated =
-            Utils::FindProperty(Utils::CreateGraphProperties(model()), property.identifier());
+        if (ids.find(property.identifier()) == ids.end())
+            continue;
+        auto it = m_properties.find(property.identifier());
+        auto updated = it == m_properties.end() ? ModelView::ExternalProperty::undefined()
+                                                : it->second;
         if (property != updated)
             scan->setProperty(ExperimentalScanItem::P_IMPORTED_DATA, updated);
     }
 }
+
+//! Remembers identifiers of graphs which are going to disappear together with given item.
+
+void ExperimentalDataController::on_about_to_remove(ModelView::SessionItem* item)
+{
+    for (auto graph : graphs_in_branch(item))
+        m_removed_ids.insert(graph->identifier());
+}
+
+//! Removes forgotten graphs from the index and unlinks scans referring to them.
+
+void ExperimentalDataController::on_removed()
+{
+    auto ids = std::move(m_removed_ids);
+    m_removed_ids.clear();
+    for (const auto& id : ids)
+        m_properties.erase(id);
+    update_scans(ids);
+}
@@ -10,15 +10,19 @@
 #ifndef DAREFL_MODEL_EXPERIMENTALDATACONTROLLER_H
 #define DAREFL_MODEL_EXPERIMENTALDATACONTROLLER_H
 
+#include <map>
+#include <mvvm/model/externalproperty.h>
 #include <mvvm/model/sessionmodel.h>
 #include <mvvm/signals/modellistener.h>
+#include <set>
 
 class InstrumentModel;
 class ExperimentalDataModel;
 
 //! Listens for all changes in ExperimentalDataModel and updates properties in InstrumentModel.
 //! Main task is to update links of ExperimentalScanItem to particular imported graph, when
-//! ExperimentalDataModel is changing.
+//! ExperimentalDataModel is changing. Keeps an index of graph properties, so a single change
+//! updates only the scans linked to the affected graphs.
 
 class ExperimentalDataController : public ModelView::ModelListener<ExperimentalDataModel>
 {
@@ -26,9 +30,17 @@ public:
     ExperimentalDataController(ExperimentalDataModel* data_model, InstrumentModel* instrument_model);
 
 private:
+    bool skip_batch();
     void update_all();
+    void update_graphs(ModelView::SessionItem* item);
+    void update_scans(const std::set<std::string>& ids);
+    void on_about_to_remove(ModelView::SessionItem* item);
+    void on_removed();
 
     InstrumentModel* m_instrument_model{nullptr};
+    std::map<std::string, ModelView::ExternalProperty> m_properties; //! graph id -> property
+    std::set<std::string> m_removed_ids; //! graphs which are about to be removed
+    bool m_index_outdated{false};        //! index has to be rebuilt on next change
 };
 
 #endif // DAREFL_MODEL_EXPERIMENTALDATACONTROLLER_H
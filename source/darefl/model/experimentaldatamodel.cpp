@@ -7,20 +7,28 @@
 //
 // ************************************************************************** //
 
+#include <darefl/model/datastitching.h>
 #include <darefl/model/experimentaldata_types.h>
 #include <darefl/model/experimentaldataitems.h>
 #include <darefl/model/experimentaldatamodel.h>
+#include <darefl/model/experimentaldatastore.h>
+#include <darefl/model/levelofdetail.h>
+#include <darefl/model/modelutils.h>
 
+#include <mvvm/interfaces/undostackinterface.h>
 #include <mvvm/model/itemcatalogue.h>
 #include <mvvm/model/modelutils.h>
+#include <mvvm/model/mvvm_types.h>
 #include <mvvm/standarditems/axisitems.h>
 #include <mvvm/standarditems/containeritem.h>
 #include <mvvm/standarditems/data1ditem.h>
 #include <mvvm/standarditems/graphitem.h>
 #include <mvvm/standarditems/graphviewportitem.h>
 
+#include <QDir>
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 using namespace ModelView;
 
@@ -28,6 +36,24 @@ namespace
 {
 
 const std::string model_name{"ExperimentalDataModel"};
+const std::string data_store_file_name{"experimentaldata.bin"};
+
+//! Datasets with more points are kept in the data store and shown decimated.
+const size_t max_points_in_model = 10000;
+
+//! Number of plot columns used for the initial view of decimated data.
+const int default_view_columns = 1000;
+
+//! Sets the flag for the lifetime of the guard, so that it is reset also on exceptions.
+class FlagGuard
+{
+public:
+    FlagGuard(bool& flag) : m_flag(flag) { m_flag = true; }
+    ~FlagGuard() { m_flag = false; }
+
+private:
+    bool& m_flag;
+};
 
 std::unique_ptr<ItemCatalogue> CreateItemCatalogue()
 {
@@ -40,18 +66,21 @@ std::unique_ptr<ItemCatalogue> CreateItemCatalogue()
 
 } // namespace
 
-ExperimentalDataModel::ExperimentalDataModel() : SessionModel(model_name)
+ExperimentalDataModel::ExperimentalDataModel()
+    : SessionModel(model_name), m_data_store(std::make_unique<ExperimentalDataStore>())
 {
     init_model();
 }
 
 ExperimentalDataModel::ExperimentalDataModel(std::shared_ptr<ItemPool> pool)
-    : SessionModel(model_name, pool)
+    : SessionModel(model_name, pool), m_data_store(std::make_unique<ExperimentalDataStore>())
 
 {
     init_model();
 }
 
+ExperimentalDataModel::~ExperimentalDataModel() = default;
+
 //! Returns the data container of the model.
 
 ExperimentalDataContainerItem* ExperimentalDataModel::dataContainer() const
@@ -71,11 +100,51 @@ CanvasItem* ExperimentalDataModel::addDataToCollection(RealDataStruct data_struc
     }
 
     if (!data_struct.data.empty())
-        addDataToGroup(group_item, data_struct);
+        refreshGraphView(addDataToGroup(group_item, data_struct));
 
     return group_item;
 }
 
+//! Inserts all data into the same group item, creating the group if necessary.
+//! Listeners checking isBatchInProgress() skip the intermediate notifications. The display
+//! refresh of the last graph is done after the batch and serves as the single consolidated change.
+CanvasItem* ExperimentalDataModel::addDataToCollection(std::vector<RealDataStruct> data_structs,
+                                                       CanvasContainerItem* data_node,
+                                                       CanvasItem* data_group)
+{
+    auto group_item = data_group;
+    if (!group_item)
+        group_item = insertItem<CanvasItem>(data_node);
+
+    std::vector<GraphItem*> graphs;
+    {
+        FlagGuard batch_guard(m_batch_in_progress);
+        for (auto& data_struct : data_structs) {
+            if (!data_struct.data.empty())
+                graphs.push_back(addDataToGroup(group_item, data_struct));
+        }
+        for (size_t i = 0; i + 1 < graphs.size(); ++i)
+            refreshGraphView(graphs[i]);
+    }
+
+    if (!graphs.empty())
+        refreshGraphView(graphs.back());
+    return group_item;
+}
+
+//! Returns true while a batch of data is being inserted.
+bool ExperimentalDataModel::isBatchInProgress() const
+{
+    return m_batch_in_progress;
+}
+
+//! Returns true while the decimated view of a data item is being replaced, e.g. on zoom and pan.
+//! Listeners interested in the data itself skip such notifications.
+bool ExperimentalDataModel::isViewUpdateInProgress() const
+{
+    return m_view_update_in_progress;
+}
+
 //! Insert the data into the group item
 void ExperimentalDataModel::removeAllDataFromCollection(CanvasContainerItem* data_node)
 {
@@ -112,40 +181,70 @@ ExperimentalDataModel::availableCanvasesInfo() const
 }
 
 //! Insert the data into the group item
-void ExperimentalDataModel::addDataToGroup(CanvasItem* data_group, RealDataStruct& data_struct)
+GraphItem* ExperimentalDataModel::addDataToGroup(CanvasItem* data_group,
+                                                 RealDataStruct& data_struct)
 {
     if (data_struct.axis.empty()) {
         data_struct.axis.resize(data_struct.data.size());
         std::iota(data_struct.axis.begin(), data_struct.axis.end(), 0);
     }
 
-    std::vector<double> axis_vec;
-    std::vector<double> data_vec;
+    // uncertainties not matching the data are dropped
+    const size_t size = data_struct.data.size();
+    const bool has_errors = data_struct.data_errors.size() == size;
+    const bool has_resolution = data_struct.axis_resolution.size() == size;
 
-    for (size_t i = 0; i < data_struct.data.size(); ++i) {
+    ExperimentalDataStore::Columns columns;
+    for (size_t i = 0; i < size; ++i) {
         if (!std::isnan(data_struct.axis.at(i)) && !std::isnan(data_struct.data.at(i))) {
-            axis_vec.push_back(data_struct.axis.at(i));
-            data_vec.push_back(data_struct.data.at(i));
+            columns.axis.push_back(data_struct.axis.at(i));
+            columns.values.push_back(data_struct.data.at(i));
+            if (has_errors)
+                columns.errors.push_back(data_struct.data_errors.at(i));
+            if (has_resolution)
+                columns.resolution.push_back(data_struct.axis_resolution.at(i));
         }
     }
 
     auto data = insertItem<Data1DItem>(dataContainer());
-    data->setAxis(PointwiseAxisItem::create(axis_vec));
-    data->setContent(data_vec);
+    if (columns.axis.size() > max_points_in_model) {
+        m_data_store->insert(data->identifier(), std::move(columns));
+        const double inf = std::numeric_limits<double>::infinity();
+        updateDataView(data, -inf, inf, default_view_columns);
+    } else {
+        data->setAxis(PointwiseAxisItem::create(columns.axis));
+        data->setContent(columns.values);
+        if (has_errors || has_resolution)
+            m_data_store->insert(data->identifier(), std::move(columns));
+    }
+    updateSourceInfo(data);
 
     auto graph = insertItem<GraphItem>(data_group);
     graph->setDisplayName(data_struct.data_name);
     graph->setData(data_struct.name);
     graph->setDataItem(data);
+    return graph;
+}
+
+//! Moves the graph in place, so that views showing it pick up its new data item.
+void ExperimentalDataModel::refreshGraphView(GraphItem* graph)
+{
     // TODO hack to refresh the ViewDataItem display (please fix)
     moveItem(graph, graph->parent(), graph->tagRow());
 }
 
-//! Remove Graph and data items from the model
+//! Remove Graph and data items from the model, together with the full-resolution data.
+//! Undo can't bring the full-resolution data back, so the undo history is dropped with it.
 void ExperimentalDataModel::removeDataFromGroup(GraphItem* item)
 {
+    const auto data_id = item->dataItem()->identifier();
     removeItem(item->dataItem()->parent(), item->dataItem()->tagRow());
     removeItem(item->parent(), item->tagRow());
+
+    m_levels_of_detail.erase(data_id);
+    m_pending_ids.erase(data_id);
+    if (m_data_store->remove(data_id) && undoStack())
+        undoStack()->clear();
 }
 
 //! check if all items are DataGroupItems, if yes return true
@@ -229,12 +328,20 @@ bool ExperimentalDataModel::dragDropItem(ModelView::SessionItem* item,
     return false;
 }
 
-//! Merges all items present into the first of the vector
+//! Merges all items present into the first of the vector. Graphs of the same canvas are stitched
+//! into a new graph instead.
 bool ExperimentalDataModel::mergeItems(std::vector<ModelView::SessionItem*> items)
 {
     if (items.size() < 1)
         return false;
 
+    if (items.size() > 1 && checkAllGraph(items)) {
+        std::vector<GraphItem*> graphs;
+        for (auto item : items)
+            graphs.push_back(static_cast<GraphItem*>(item));
+        return stitchGraphs(graphs) != nullptr;
+    }
+
     for (int i = 1; i < items.size(); ++i) {
         for (auto child : items.at(i)->children()) {
             if (child->parent()->isSinglePropertyTag(child->tag()))
@@ -247,11 +354,217 @@ bool ExperimentalDataModel::mergeItems(std::vector<ModelView::SessionItem*> item
     return true;
 }
 
+//! Stitches full-resolution data of graphs measured in overlapping q-ranges and adds the result
+//! as a new graph to the canvas of the first graph. The common grid has as many bins as the
+//! largest of the graphs has points.
+GraphItem* ExperimentalDataModel::stitchGraphs(const std::vector<GraphItem*>& graphs)
+{
+    if (graphs.empty())
+        return nullptr;
+
+    std::vector<DataStitching::Curve> curves;
+    size_t n_bins{0};
+    for (auto graph : graphs) {
+        curves.push_back({::Utils::SourceAxis(graph), ::Utils::SourceValues(graph),
+                          ::Utils::SourceErrors(graph)});
+        n_bins = std::max(n_bins, curves.back().axis.size());
+    }
+    auto stitched = DataStitching::Stitch(std::move(curves), static_cast<int>(n_bins));
+
+    RealDataStruct data_struct;
+    data_struct.name = "stitched";
+    data_struct.data_name = "Stitched";
+    data_struct.axis = std::move(stitched.axis);
+    data_struct.data = std::move(stitched.values);
+    data_struct.data_errors = std::move(stitched.errors);
+
+    auto canvas = static_cast<CanvasItem*>(graphs.front()->parent());
+    auto graph = addDataToGroup(canvas, data_struct);
+    refreshGraphView(graph);
+    return graph;
+}
+
 CanvasContainerItem* ExperimentalDataModel::canvasContainer() const
 {
     return topItem<CanvasContainerItem>();
 }
 
+ExperimentalDataStore* ExperimentalDataModel::dataStore() const
+{
+    return m_data_store.get();
+}
+
+//! Returns the axis of the data in full resolution, or empty vector while it is being loaded.
+std::vector<double> ExperimentalDataModel::sourceAxis(const Data1DItem* data) const
+{
+    if (auto columns = m_data_store->columns(data->identifier()); columns)
+        return columns->axis;
+    return isSourcePending(data) ? std::vector<double>() : data->binCenters();
+}
+
+//! Returns values of the data in full resolution, or empty vector while they are being loaded.
+std::vector<double> ExperimentalDataModel::sourceValues(const Data1DItem* data) const
+{
+    if (auto columns = m_data_store->columns(data->identifier()); columns)
+        return columns->values;
+    return isSourcePending(data) ? std::vector<double>() : data->binValues();
+}
+
+//! Returns uncertainties of the data values, or empty vector if they are unknown.
+std::vector<double> ExperimentalDataModel::sourceErrors(const Data1DItem* data) const
+{
+    auto columns = m_data_store->columns(data->identifier());
+    return columns ? columns->errors : std::vector<double>();
+}
+
+//! Returns uncertainties of the axis values, or empty vector if they are unknown.
+std::vector<double> ExperimentalDataModel::sourceResolution(const Data1DItem* data) const
+{
+    auto columns = m_data_store->columns(data->identifier());
+    return columns ? columns->resolution : std::vector<double>();
+}
+
+//! Returns true if the data item contains only a decimated view of the data. While the source of
+//! the data item is pending, this isn't known yet and false is returned.
+bool ExperimentalDataModel::isDecimated(const Data1DItem* data) const
+{
+    auto columns = m_data_store->columns(data->identifier());
+    return columns && columns->axis.size() > max_points_in_model;
+}
+
+//! Returns true if the data item belongs to the opened project whose stored data isn't loaded yet.
+bool ExperimentalDataModel::isSourcePending(const Data1DItem* data) const
+{
+    return m_pending_ids.find(data->identifier()) != m_pending_ids.end();
+}
+
+//! Saves full-resolution data of all data items into the project directory.
+bool ExperimentalDataModel::saveDataStore(const std::string& dirname) const
+{
+    return ExperimentalDataStore::write(dataStoreFileName(dirname), dataStoreEntries());
+}
+
+//! Loads full-resolution data from the project directory.
+bool ExperimentalDataModel::loadDataStore(const std::string& dirname)
+{
+    ExperimentalDataStore::entries_t entries;
+    bool success = ExperimentalDataStore::read(dataStoreFileName(dirname), entries);
+    setDataStoreEntries(entries);
+    return success;
+}
+
+//! Returns the name of the file with full-resolution data in the project directory.
+std::string ExperimentalDataModel::dataStoreFileName(const std::string& dirname)
+{
+    return QDir(QString::fromStdString(dirname))
+        .filePath(QString::fromStdString(data_store_file_name))
+        .toStdString();
+}
+
+//! Returns full-resolution data of all data items. Entries share immutable columns with the
+//! store and can be written in another thread while the model is being edited.
+ExperimentalDataStore::entries_t ExperimentalDataModel::dataStoreEntries() const
+{
+    std::vector<std::string> keys;
+    for (auto item : dataContainer()->children())
+        keys.push_back(item->identifier());
+    return m_data_store->entries(keys);
+}
+
+//! Replaces full-resolution data of data items, e.g. after it was read in another thread. Sources
+//! of data items are no longer pending. Their data change notifies listeners about the new
+//! source, see updateSourceInfo().
+void ExperimentalDataModel::setDataStoreEntries(const ExperimentalDataStore::entries_t& entries)
+{
+    m_levels_of_detail.clear();
+    m_data_store->assign(entries);
+    m_pending_ids.clear();
+    for (auto data : dataContainer()->items<Data1DItem>(dataContainer()->defaultTag()))
+        updateSourceInfo(data);
+}
+
+//! Adds full-resolution data of given data items, e.g. recovered after a crash, and replaces their
+//! previous data. Sources of other data items stay pending until setDataStoreEntries().
+void ExperimentalDataModel::addDataStoreEntries(const ExperimentalDataStore::entries_t& entries)
+{
+    auto merged = entries;
+    for (const auto& entry : dataStoreEntries()) {
+        auto has_key = [&entry](const auto& other) { return other.first == entry.first; };
+        if (std::none_of(merged.begin(), merged.end(), has_key))
+            merged.push_back(entry);
+    }
+    for (const auto& entry : entries) {
+        m_levels_of_detail.erase(entry.first);
+        m_pending_ids.erase(entry.first);
+    }
+    m_data_store->assign(merged);
+    for (auto data : dataContainer()->items<Data1DItem>(dataContainer()->defaultTag()))
+        updateSourceInfo(data);
+}
+
+//! Drops full-resolution data and marks sources of all data items as pending, until the stored
+//! data of the opened project is set by setDataStoreEntries().
+void ExperimentalDataModel::beginDataStoreLoad()
+{
+    m_levels_of_detail.clear();
+    m_data_store->assign({});
+    m_pending_ids.clear();
+    auto data_items = dataContainer()->items<Data1DItem>(dataContainer()->defaultTag());
+    for (auto data : data_items)
+        m_pending_ids.insert(data->identifier());
+    for (auto data : data_items)
+        updateSourceInfo(data);
+}
+
+//! Replaces the content of the data item with the decimated view of the stored data.
+//! Level of detail of every dataset is cached, so repeated zoom and pan are cheap. The view is
+//! derived from the stored data and changes on every zoom and pan, so once the data item has its
+//! axis, the view is replaced directly, without undo commands.
+void ExperimentalDataModel::updateDataView(Data1DItem* data, double xmin, double xmax,
+                                           int n_columns, bool log_scale)
+{
+    if (!isDecimated(data))
+        return;
+
+    FlagGuard view_guard(m_view_update_in_progress);
+    auto columns = m_data_store->columns(data->identifier());
+    auto& lod = m_levels_of_detail[data->identifier()];
+    if (!lod || lod->columns() != columns)
+        lod = std::make_unique<LevelOfDetail>(columns);
+
+    auto indices = lod->indices(xmin, xmax, n_columns, log_scale);
+    std::vector<double> axis_vec, data_vec;
+    axis_vec.reserve(indices.size());
+    data_vec.reserve(indices.size());
+    for (auto index : indices) {
+        axis_vec.push_back(columns->axis[index]);
+        data_vec.push_back(columns->values[index]);
+    }
+
+    auto axis = data->item<PointwiseAxisItem>(Data1DItem::T_AXIS);
+    if (!axis) {
+        data->setAxis(PointwiseAxisItem::create(axis_vec));
+        data->setContent(data_vec);
+        return;
+    }
+
+    axis->setData(axis_vec, ItemDataRole::DATA, /*direct*/ true);
+    data->setData(data_vec, ItemDataRole::DATA, /*direct*/ true);
+}
+
+//! Describes the source of the data in the tooltip of the data item. The tooltip changes when
+//! the stored data of the item arrives, so listeners learn about the new source.
+void ExperimentalDataModel::updateSourceInfo(Data1DItem* data)
+{
+    std::string info;
+    if (isSourcePending(data))
+        info = "Loading data in full resolution";
+    else if (isDecimated(data))
+        info = "Decimated view of "
+               + std::to_string(m_data_store->columns(data->identifier())->axis.size()) + " points";
+    data->setData(info, ItemDataRole::TOOLTIP, /*direct*/ true);
+}
+
 void ExperimentalDataModel::init_model()
 {
     setItemCatalogue(CreateItemCatalogue());
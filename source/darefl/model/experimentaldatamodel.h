@@ -10,22 +10,32 @@
 #ifndef DAREFL_MODEL_EXPERIMENTALDATAMODEL_H
 #define DAREFL_MODEL_EXPERIMENTALDATAMODEL_H
 
+#include <darefl/model/experimentaldatastore.h>
+#include <map>
+#include <memory>
 #include <mvvm/model/sessionmodel.h>
+#include <set>
 #include <vector>
 
 class CanvasContainerItem;
 class ExperimentalDataContainerItem;
+class LevelOfDetail;
 class CanvasItem;
 class RealDataStruct;
 
 namespace ModelView
 {
 class SessionItem;
+class Data1DItem;
 class GraphItem;
 class GraphViewportItem;
 } // namespace ModelView
 
 //! The model to store imported reflectometry data.
+//! Large datasets are kept in full resolution in ExperimentalDataStore, while their data items
+//! contain only a decimated view for the visible range of the canvas. Uncertainties of the data
+//! are kept in the store for datasets of any size. While the store of an opened project is being
+//! loaded, data items of the project may contain decimated views, so their source is unknown.
 
 class ExperimentalDataModel : public ModelView::SessionModel
 {
@@ -34,9 +44,15 @@ public:
 
     ExperimentalDataModel();
     ExperimentalDataModel(std::shared_ptr<ModelView::ItemPool> pool);
+    ~ExperimentalDataModel() override;
 
     CanvasItem* addDataToCollection(RealDataStruct data_struct, CanvasContainerItem* data_node,
                                     CanvasItem* data_group = nullptr);
+    CanvasItem* addDataToCollection(std::vector<RealDataStruct> data_structs,
+                                    CanvasContainerItem* data_node,
+                                    CanvasItem* data_group = nullptr);
+    bool isBatchInProgress() const;
+    bool isViewUpdateInProgress() const;
 
     void removeAllDataFromCollection(CanvasContainerItem* data_node);
     void removeDataFromCollection(std::vector<ModelView::SessionItem*> item_to_remove);
@@ -49,16 +65,43 @@ public:
     bool dropEnabled(ModelView::SessionItem* item) const;
     bool dragDropItem(ModelView::SessionItem* item, ModelView::SessionItem* target, int row = -1);
     bool mergeItems(std::vector<ModelView::SessionItem*> items);
+    ModelView::GraphItem* stitchGraphs(const std::vector<ModelView::GraphItem*>& graphs);
 
     CanvasContainerItem* canvasContainer() const;
 
+    ExperimentalDataStore* dataStore() const;
+    void updateDataView(ModelView::Data1DItem* data, double xmin, double xmax, int n_columns,
+                        bool log_scale = false);
+    std::vector<double> sourceAxis(const ModelView::Data1DItem* data) const;
+    std::vector<double> sourceValues(const ModelView::Data1DItem* data) const;
+    std::vector<double> sourceErrors(const ModelView::Data1DItem* data) const;
+    std::vector<double> sourceResolution(const ModelView::Data1DItem* data) const;
+    bool isDecimated(const ModelView::Data1DItem* data) const;
+    bool isSourcePending(const ModelView::Data1DItem* data) const;
+
+    bool saveDataStore(const std::string& dirname) const;
+    bool loadDataStore(const std::string& dirname);
+    static std::string dataStoreFileName(const std::string& dirname);
+    ExperimentalDataStore::entries_t dataStoreEntries() const;
+    void setDataStoreEntries(const ExperimentalDataStore::entries_t& entries);
+    void addDataStoreEntries(const ExperimentalDataStore::entries_t& entries);
+    void beginDataStoreLoad();
+
 private:
     ExperimentalDataContainerItem* dataContainer() const;
 
-    void addDataToGroup(CanvasItem* data_group, RealDataStruct& data_struct);
+    ModelView::GraphItem* addDataToGroup(CanvasItem* data_group, RealDataStruct& data_struct);
+    void refreshGraphView(ModelView::GraphItem* graph);
     void removeDataFromGroup(ModelView::GraphItem* item);
+    void updateSourceInfo(ModelView::Data1DItem* data);
 
     void init_model();
+
+    bool m_batch_in_progress{false};
+    bool m_view_update_in_progress{false};
+    std::set<std::string> m_pending_ids; //! data items waiting for the store of opened project
+    std::unique_ptr<ExperimentalDataStore> m_data_store;
+    std::map<std::string, std::unique_ptr<LevelOfDetail>> m_levels_of_detail;
 };
 
 #endif // DAREFL_MODEL_EXPERIMENTALDATAMODEL_H
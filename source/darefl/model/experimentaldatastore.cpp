@@ -0,0 +1,387 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <algorithm>
+#include <cstring>
+#include <darefl/model/experimentaldatastore.h>
+#include <numeric>
+#include <stdexcept>
+
+namespace
+{
+const quint32 store_magic = 0x44524653; // "DRFS"
+// Version 1 didn't contain errors and resolution. Version 2 was QDataStream throughout. Since
+// version 3, everything after the header is raw native data, with columns aligned to 8 bytes
+// and protected by a checksum. Columns are verified in the memory-mapped file and copied from it
+// once. Version 4 starts raw data with the byte order mark and checksums columns by 64-bit words.
+const quint32 store_version = 4;
+const quint32 last_stream_version = 2;
+const quint32 last_bytewise_version = 3;
+
+//! Written natively, so files of another byte order aren't taken for corrupted ones.
+const quint64 byte_order_mark = 0x0102030405060708ull;
+
+const quint64 fnv_offset = 14695981039346656037ull;
+const quint64 fnv_prime = 1099511628211ull;
+
+//! Returns FNV-1a hash of the given bytes, used up to version 3.
+quint64 bytewise_checksum(const char* data, size_t size)
+{
+    quint64 result = fnv_offset;
+    for (size_t i = 0; i < size; ++i) {
+        result ^= static_cast<unsigned char>(data[i]);
+        result *= fnv_prime;
+    }
+    return result;
+}
+
+//! Returns the hash of the given bytes taken as 64-bit words, the size is a multiple of 8. Every
+//! step is FNV-1a on the whole word followed by folding of high bits, which takes one
+//! multiplication per 8 bytes instead of 8.
+quint64 checksum(const char* data, size_t size)
+{
+    quint64 result = fnv_offset;
+    for (size_t i = 0; i < size; i += sizeof(quint64)) {
+        quint64 word;
+        std::memcpy(&word, data + i, sizeof(word));
+        result = (result ^ word) * fnv_prime;
+        result ^= result >> 32;
+    }
+    return result;
+}
+
+//! Returns the size rounded up to the multiple of 8 bytes.
+size_t aligned(size_t size)
+{
+    return (size + 7) & ~size_t(7);
+}
+
+bool write_raw(QIODevice& device, const void* data, size_t size)
+{
+    return device.write(static_cast<const char*>(data), static_cast<qint64>(size))
+           == static_cast<qint64>(size);
+}
+
+bool write_raw(QIODevice& device, quint64 value)
+{
+    return write_raw(device, &value, sizeof(value));
+}
+
+//! Writes the key as its length followed by UTF-8 bytes, padded to 8 bytes.
+bool write_key(QIODevice& device, const std::string& key)
+{
+    const std::string padding(aligned(key.size()) - key.size(), '\0');
+    return write_raw(device, key.size()) && write_raw(device, key.data(), key.size())
+           && write_raw(device, padding.data(), padding.size());
+}
+
+//! Writes the column as the number of raw doubles, their checksum and doubles themselves.
+bool write_blob(QIODevice& device, const std::vector<double>& column)
+{
+    const auto data = reinterpret_cast<const char*>(column.data());
+    const size_t size = column.size() * sizeof(double);
+    return write_raw(device, column.size()) && write_raw(device, checksum(data, size))
+           && write_raw(device, data, size);
+}
+
+//! Sequential reader of the memory-mapped file. All reads are checked against the file size.
+class MappedReader
+{
+public:
+    MappedReader(const uchar* data, size_t size, size_t offset, quint32 version)
+        : m_data(reinterpret_cast<const char*>(data)), m_size(size), m_offset(offset),
+          m_version(version)
+    {
+    }
+
+    bool read(void* result, size_t size)
+    {
+        if (!take(size))
+            return false;
+        std::memcpy(result, m_data + m_offset - size, size);
+        return true;
+    }
+
+    bool read(quint64& value) { return read(&value, sizeof(value)); }
+
+    bool read_key(std::string& key)
+    {
+        quint64 size{0};
+        if (!read(size) || size > m_size)
+            return false;
+        const char* data = m_data + m_offset;
+        if (!take(aligned(size)))
+            return false;
+        key.assign(data, size);
+        return true;
+    }
+
+    //! Verifies the checksum of the column in the mapped file and copies the column.
+    bool read_blob(std::vector<double>& column)
+    {
+        quint64 count{0}, expected_checksum{0};
+        if (!read(count) || !read(expected_checksum) || count > m_size / sizeof(double))
+            return false;
+        const size_t size = count * sizeof(double);
+        const char* data = m_data + m_offset;
+        if (!take(size))
+            return false;
+        const auto actual_checksum = m_version > last_bytewise_version
+                                         ? checksum(data, size)
+                                         : bytewise_checksum(data, size);
+        if (actual_checksum != expected_checksum)
+            return false;
+        column.resize(count);
+        std::memcpy(column.data(), data, size);
+        return true;
+    }
+
+private:
+    bool take(size_t size)
+    {
+        if (size > m_size - m_offset)
+            return false;
+        m_offset += size;
+        return true;
+    }
+
+    const char* m_data{nullptr};
+    size_t m_size{0};
+    size_t m_offset{0};
+    quint32 m_version{0};
+};
+
+//! Reads the column written in QDataStream by earlier versions.
+bool read_column(QDataStream& stream, std::vector<double>& column)
+{
+    quint64 size{0};
+    stream >> size;
+    if (stream.status() != QDataStream::Ok || size > static_cast<quint64>(stream.device()->size()))
+        return false;
+    column.resize(size);
+    const int length = static_cast<int>(size * sizeof(double));
+    return stream.readRawData(reinterpret_cast<char*>(column.data()), length) == length;
+}
+
+//! Reads entries written in QDataStream by earlier versions, after the header.
+bool read_stream(QDataStream& stream, quint32 version, ExperimentalDataStore::entries_t& entries,
+                 const ExperimentalDataStore::progress_t& progress)
+{
+    quint64 count{0};
+    stream >> count;
+    for (quint64 i = 0; i < count; ++i) {
+        QString key;
+        auto entry = std::make_shared<ExperimentalDataStore::Columns>();
+        stream >> key;
+        bool success = read_column(stream, entry->axis) && read_column(stream, entry->values);
+        if (success && version > 1)
+            success = read_column(stream, entry->errors) && read_column(stream, entry->resolution);
+        if (!success)
+            return false;
+        entries.emplace_back(key.toStdString(), std::move(entry));
+        if (progress)
+            progress(static_cast<int>(100 * (i + 1) / count));
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+//! Reads entries from the memory-mapped file, after the header. Files of another byte order
+//! aren't read.
+bool read_mapped(QFile& file, quint32 version, ExperimentalDataStore::entries_t& entries,
+                 const ExperimentalDataStore::progress_t& progress)
+{
+    const auto size = static_cast<size_t>(file.size());
+    auto data = file.map(0, file.size());
+    if (!data)
+        return false;
+
+    MappedReader reader(data, size, 2 * sizeof(quint32), version);
+    quint64 mark{0}, count{0};
+    bool success = version <= last_bytewise_version
+                   || (reader.read(mark) && mark == byte_order_mark);
+    success = success && reader.read(count) && count <= size;
+    for (quint64 i = 0; success && i < count; ++i) {
+        std::string key;
+        auto entry = std::make_shared<ExperimentalDataStore::Columns>();
+        success = reader.read_key(key) && reader.read_blob(entry->axis)
+                  && reader.read_blob(entry->values) && reader.read_blob(entry->errors)
+                  && reader.read_blob(entry->resolution);
+        if (!success)
+            break;
+        entries.emplace_back(key, std::move(entry));
+        if (progress)
+            progress(static_cast<int>(100 * (i + 1) / count));
+    }
+
+    file.unmap(data);
+    return success;
+}
+
+//! Returns the column with elements taken in the given order. Empty column stays empty.
+std::vector<double> reordered(const std::vector<double>& column, const std::vector<size_t>& order)
+{
+    std::vector<double> result;
+    if (column.empty())
+        return result;
+    result.reserve(order.size());
+    for (auto index : order)
+        result.push_back(column[index]);
+    return result;
+}
+
+} // namespace
+
+//! Stores the data under given key. Points are sorted along the axis, as required for decimation.
+
+void ExperimentalDataStore::insert(const std::string& key, std::vector<double> axis,
+                                   std::vector<double> values)
+{
+    insert(key, Columns{std::move(axis), std::move(values), {}, {}});
+}
+
+//! Stores the data together with its uncertainties under given key. Points are sorted along
+//! the axis, as required for decimation.
+
+void ExperimentalDataStore::insert(const std::string& key, Columns columns)
+{
+    const size_t size = columns.axis.size();
+    if (columns.values.size() != size || (!columns.errors.empty() && columns.errors.size() != size)
+        || (!columns.resolution.empty() && columns.resolution.size() != size))
+        throw std::runtime_error("ExperimentalDataStore: columns have different size");
+
+    if (!std::is_sorted(columns.axis.begin(), columns.axis.end())) {
+        const auto& axis = columns.axis;
+        std::vector<size_t> order(size);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&axis](auto left, auto right) { return axis[left] < axis[right]; });
+        columns = Columns{reordered(columns.axis, order), reordered(columns.values, order),
+                          reordered(columns.errors, order), reordered(columns.resolution, order)};
+    }
+    m_columns[key] = std::make_shared<Columns>(std::move(columns));
+}
+
+//! Returns columns stored under given key, or nullptr.
+
+ExperimentalDataStore::columns_t ExperimentalDataStore::columns(const std::string& key) const
+{
+    auto it = m_columns.find(key);
+    return it == m_columns.end() ? nullptr : it->second;
+}
+
+//! Removes the data with given key, returns false if there was none.
+
+bool ExperimentalDataStore::remove(const std::string& key)
+{
+    return m_columns.erase(key) > 0;
+}
+
+void ExperimentalDataStore::clear()
+{
+    m_columns.clear();
+}
+
+//! Returns entries with given keys, skipping keys unknown to the store. Entries share the
+//! immutable columns with the store.
+
+ExperimentalDataStore::entries_t
+ExperimentalDataStore::entries(const std::vector<std::string>& keys) const
+{
+    entries_t result;
+    for (const auto& key : keys)
+        if (auto entry = columns(key))
+            result.emplace_back(key, entry);
+    return result;
+}
+
+//! Replaces the content of the store with given entries.
+
+void ExperimentalDataStore::assign(const entries_t& entries)
+{
+    m_columns = std::map<std::string, columns_t>(entries.begin(), entries.end());
+}
+
+//! Saves columns with given keys into the file. Keys unknown to the store are skipped.
+
+bool ExperimentalDataStore::save(const std::string& file_name,
+                                 const std::vector<std::string>& keys) const
+{
+    return write(file_name, entries(keys));
+}
+
+//! Replaces the content of the store with the content of the file.
+//! Missing file means no stored data and leaves the store empty.
+
+bool ExperimentalDataStore::load(const std::string& file_name)
+{
+    clear();
+    entries_t result;
+    if (!read(file_name, result))
+        return false;
+    assign(result);
+    return true;
+}
+
+//! Writes entries into the file.
+
+bool ExperimentalDataStore::write(const std::string& file_name, const entries_t& entries,
+                                  const progress_t& progress)
+{
+    QSaveFile file(QString::fromStdString(file_name));
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_12);
+    stream << store_magic << store_version;
+    bool success = stream.status() == QDataStream::Ok && write_raw(file, byte_order_mark)
+                   && write_raw(file, entries.size());
+    for (size_t i = 0; success && i < entries.size(); ++i) {
+        const auto& [key, entry] = entries[i];
+        success = write_key(file, key) && write_blob(file, entry->axis)
+                  && write_blob(file, entry->values) && write_blob(file, entry->errors)
+                  && write_blob(file, entry->resolution);
+        if (progress)
+            progress(static_cast<int>(100 * (i + 1) / entries.size()));
+    }
+
+    return success && file.commit();
+}
+
+//! Reads entries from the file. Missing file means no stored data. On failure, no entries are
+//! returned.
+
+bool ExperimentalDataStore::read(const std::string& file_name, entries_t& entries,
+                                 const progress_t& progress)
+{
+    entries.clear();
+    QFile file(QString::fromStdString(file_name));
+    if (!file.exists())
+        return true;
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_12);
+    quint32 magic{0}, version{0};
+    stream >> magic >> version;
+    if (stream.status() != QDataStream::Ok || magic != store_magic || version < 1
+        || version > store_version)
+        return false;
+
+    bool success = version > last_stream_version
+                       ? read_mapped(file, version, entries, progress)
+                       : read_stream(stream, version, entries, progress);
+    if (!success)
+        entries.clear();
+    return success;
+}
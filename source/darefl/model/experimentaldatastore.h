@@ -0,0 +1,59 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#ifndef DAREFL_MODEL_EXPERIMENTALDATASTORE_H
+#define DAREFL_MODEL_EXPERIMENTALDATASTORE_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+//! Columnar storage of full-resolution experimental data, outside of the session model.
+//! Columns are immutable and shared, so readers can keep them while the store changes.
+//! Uncertainties of the data are kept next to the values they belong to.
+//! Static read() and write() don't touch the store and can run in a worker thread on a snapshot
+//! of entries. In the file, columns are raw doubles with a checksum, read via memory mapping.
+
+class ExperimentalDataStore
+{
+public:
+    struct Columns {
+        std::vector<double> axis;
+        std::vector<double> values;
+        std::vector<double> errors;     //! standard deviation of values, empty if unknown
+        std::vector<double> resolution; //! standard deviation of axis values, empty if unknown
+    };
+    using columns_t = std::shared_ptr<const Columns>;
+    using entries_t = std::vector<std::pair<std::string, columns_t>>;
+    using progress_t = std::function<void(int)>; //! reports percentage of processed entries
+
+    void insert(const std::string& key, std::vector<double> axis, std::vector<double> values);
+    void insert(const std::string& key, Columns columns);
+    columns_t columns(const std::string& key) const;
+    bool remove(const std::string& key);
+    void clear();
+
+    entries_t entries(const std::vector<std::string>& keys) const;
+    void assign(const entries_t& entries);
+
+    bool save(const std::string& file_name, const std::vector<std::string>& keys) const;
+    bool load(const std::string& file_name);
+
+    static bool write(const std::string& file_name, const entries_t& entries,
+                      const progress_t& progress = {});
+    static bool read(const std::string& file_name, entries_t& entries,
+                     const progress_t& progress = {});
+
+private:
+    std::map<std::string, columns_t> m_columns;
+};
+
+#endif // DAREFL_MODEL_EXPERIMENTALDATASTORE_H
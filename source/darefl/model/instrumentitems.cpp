@@ -23,6 +23,13 @@ BasicSpecularScanItem::BasicSpecularScanItem(const std::string& model_type)
 {
 }
 
+//! Returns standard deviation of every q-value of the scan, or empty vector for the ideal scan.
+
+std::vector<double> BasicSpecularScanItem::qScanResolution() const
+{
+    return {};
+}
+
 // ----------------------------------------------------------------------------
 
 QSpecScanItem::QSpecScanItem() : BasicSpecularScanItem(::Constants::QSpecScanItemType)
@@ -64,7 +71,12 @@ GraphItem* ExperimentalScanItem::graphItem() const
 
 std::vector<double> ExperimentalScanItem::qScanValues() const
 {
-    return graphItem() ? graphItem()->binCenters() : std::vector<double>();
+    return graphItem() ? ::Utils::SourceAxis(graphItem()) : std::vector<double>();
+}
+
+std::vector<double> ExperimentalScanItem::qScanResolution() const
+{
+    return graphItem() ? ::Utils::SourceResolution(graphItem()) : std::vector<double>();
 }
 
 // ----------------------------------------------------------------------------
@@ -93,6 +105,15 @@ std::vector<double> SpecularBeamItem::qScanValues() const
     return {};
 }
 
+std::vector<double> SpecularBeamItem::qScanResolution() const
+{
+    auto scan_group = item<SpecularScanGroupItem>(P_SCAN_GROUP);
+    if (auto scanItem = dynamic_cast<const BasicSpecularScanItem*>(scan_group->currentItem());
+        scanItem)
+        return scanItem->qScanResolution();
+    return {};
+}
+
 double SpecularBeamItem::intensity() const
 {
     return property<double>(P_INTENSITY);
@@ -28,6 +28,7 @@ class BasicSpecularScanItem : public ModelView::CompoundItem
 public:
     BasicSpecularScanItem(const std::string& model_type);
     virtual std::vector<double> qScanValues() const = 0;
+    virtual std::vector<double> qScanResolution() const;
 };
 
 //! Represents Q-space specular scan with fixed bin size.
@@ -56,6 +57,7 @@ public:
     ModelView::GraphItem* graphItem() const;
 
     std::vector<double> qScanValues() const override;
+    std::vector<double> qScanResolution() const override;
 };
 
 //! Represent selection of possible specular scans.
@@ -77,6 +79,7 @@ public:
     SpecularBeamItem();
 
     std::vector<double> qScanValues() const;
+    std::vector<double> qScanResolution() const;
 
     double intensity() const;
 
@@ -14,7 +14,10 @@
 #include <darefl/model/jobmodel.h>
 #include <mvvm/model/modelutils.h>
 #include <mvvm/standarditems/axisitems.h>
+#include <mvvm/standarditems/colormapitem.h>
+#include <mvvm/standarditems/colormapviewportitem.h>
 #include <mvvm/standarditems/data1ditem.h>
+#include <mvvm/standarditems/data2ditem.h>
 #include <mvvm/standarditems/graphitem.h>
 #include <mvvm/standarditems/graphviewportitem.h>
 #include <QColor>
@@ -50,6 +53,7 @@ JobItem::JobItem() : ModelView::CompoundItem(::Constants::JobItemType)
 {
     setup_sld_viewport();
     setup_specular_viewport();
+    setup_field_viewport();
 }
 
 Data1DItem* JobItem::sld_data() const
@@ -72,6 +76,18 @@ CanvasItem* JobItem::specular_viewport() const
     return item<CanvasItem>(P_SPECULAR_VIEWPORT);
 }
 
+//! Returns data item with the intensity of the wave field inside the sample (x - depth, y - q).
+
+Data2DItem* JobItem::field_data() const
+{
+    return item<Data2DItem>(P_FIELD_DATA);
+}
+
+ColorMapViewportItem* JobItem::field_viewport() const
+{
+    return item<ColorMapViewportItem>(P_FIELD_VIEWPORT);
+}
+
 GraphItem* JobItem::referenceGraph() const
 {
     auto graphs = specular_viewport()->graphItems();
@@ -112,3 +128,12 @@ void JobItem::setup_specular_viewport()
     graph->setDataItem(data);
     viewport->insertItem(graph.release(), {ViewportItem::T_ITEMS, row_sim_graph});
 }
+
+void JobItem::setup_field_viewport()
+{
+    auto data = addProperty<Data2DItem>(P_FIELD_DATA);
+    auto viewport = addProperty<ColorMapViewportItem>(P_FIELD_VIEWPORT);
+    auto colormap = std::make_unique<ColorMapItem>();
+    colormap->setDataItem(data);
+    viewport->insertItem(colormap.release(), {ViewportItem::T_ITEMS, 0});
+}
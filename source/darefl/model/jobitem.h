@@ -15,7 +15,9 @@
 
 namespace ModelView
 {
+class ColorMapViewportItem;
 class Data1DItem;
+class Data2DItem;
 class GraphViewportItem;
 } // namespace ModelView
 
@@ -43,6 +45,8 @@ public:
     static inline const std::string P_SLD_VIEWPORT = "P_SLD_VIEWPORT";
     static inline const std::string P_SPECULAR_DATA = "P_SPECULAR_DATA";
     static inline const std::string P_SPECULAR_VIEWPORT = "P_SPECULAR_VIEWPORT";
+    static inline const std::string P_FIELD_DATA = "P_FIELD_DATA";
+    static inline const std::string P_FIELD_VIEWPORT = "P_FIELD_VIEWPORT";
 
     JobItem();
 
@@ -52,6 +56,9 @@ public:
     ModelView::Data1DItem* specular_data() const;
     CanvasItem* specular_viewport() const;
 
+    ModelView::Data2DItem* field_data() const;
+    ModelView::ColorMapViewportItem* field_viewport() const;
+
     ModelView::GraphItem* referenceGraph() const;
 
     void updateReferenceGraphFrom(const SpecularInstrumentItem* instrument);
@@ -60,6 +67,7 @@ private:
     void setup_graph(const std::string& data_tag, const std::string& viewport_tag);
     void setup_sld_viewport();
     void setup_specular_viewport();
+    void setup_field_viewport();
 };
 
 #endif // DAREFL_MODEL_JOBITEM_H
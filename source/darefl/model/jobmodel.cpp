@@ -64,6 +64,16 @@ CanvasItem* JobModel::specular_viewport() const
     return job_item()->specular_viewport();
 }
 
+Data2DItem* JobModel::field_data() const
+{
+    return job_item()->field_data();
+}
+
+ColorMapViewportItem* JobModel::field_viewport() const
+{
+    return job_item()->field_viewport();
+}
+
 void JobModel::updateReferenceGraphFrom(const SpecularInstrumentItem* instrument)
 {
     job_item()->updateReferenceGraphFrom(instrument);
@@ -14,7 +14,9 @@
 
 namespace ModelView
 {
+class ColorMapViewportItem;
 class Data1DItem;
+class Data2DItem;
 class GraphViewportItem;
 class ItemPool;
 } // namespace ModelView
@@ -36,6 +38,9 @@ public:
     ModelView::Data1DItem* specular_data() const;
     CanvasItem* specular_viewport() const;
 
+    ModelView::Data2DItem* field_data() const;
+    ModelView::ColorMapViewportItem* field_viewport() const;
+
     void updateReferenceGraphFrom(const SpecularInstrumentItem* instrument);
 
 private:
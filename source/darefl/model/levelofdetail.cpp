@@ -0,0 +1,131 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include <algorithm>
+#include <cmath>
+#include <darefl/model/datadecimation.h>
+#include <darefl/model/levelofdetail.h>
+
+namespace
+{
+
+//! Maximum number of cached columns for all levels, the cache is dropped when exceeded.
+const size_t max_cached_columns = 1 << 18;
+
+//! Maximum column index handled by the level grid.
+const double max_column_index = 1e15;
+
+} // namespace
+
+LevelOfDetail::LevelOfDetail(ExperimentalDataStore::columns_t columns)
+    : m_columns(std::move(columns))
+{
+}
+
+ExperimentalDataStore::columns_t LevelOfDetail::columns() const
+{
+    return m_columns;
+}
+
+//! Returns indices of points representing the curve within [xmin, xmax] on a plot with given
+//! number of columns. With log scale non-positive values are not taken as minimum, since they
+//! can't be shown. See Utils::MinMaxDecimation for the rest of the contract.
+
+std::vector<size_t> LevelOfDetail::indices(double xmin, double xmax, int n_columns,
+                                           bool log_scale)
+{
+    const auto& x = m_columns->axis;
+    if (x.empty())
+        return {};
+
+    xmin = std::max(xmin, x.front());
+    xmax = std::min(xmax, x.back());
+    const double column_width = (xmax - xmin) / n_columns;
+    if (n_columns <= 0 || !(column_width > 0.0) || !std::isfinite(column_width))
+        return Utils::MinMaxDecimation(x, m_columns->values, xmin, xmax, n_columns);
+
+    int exponent{0};
+    std::frexp(column_width, &exponent);
+    const double width = std::ldexp(1.0, exponent - 1); // largest power of two <= column_width
+    if (std::max(std::abs(xmin), std::abs(xmax)) / width > max_column_index)
+        return Utils::MinMaxDecimation(x, m_columns->values, xmin, xmax, n_columns);
+
+    const auto first_column = static_cast<long long>(std::floor(xmin / width));
+    const auto last_column = static_cast<long long>(std::floor(xmax / width));
+    const level_t level{exponent, log_scale};
+
+    std::vector<size_t> result;
+    for (auto index = first_column; index <= last_column; ++index) {
+        const auto& col = column(level, index, width);
+        if (col.empty)
+            continue;
+        size_t points[] = {col.first, std::min(col.min, col.max), std::max(col.min, col.max),
+                           col.last};
+        for (auto point : points)
+            if (result.empty() || result.back() < point)
+                result.push_back(point);
+    }
+
+    // nearest points outside of the range keep lines continuous
+    if (!result.empty()) {
+        if (result.front() > 0)
+            result.insert(result.begin(), result.front() - 1);
+        if (result.back() + 1 < x.size())
+            result.push_back(result.back() + 1);
+    }
+
+    return result;
+}
+
+//! Returns column with given index on the given level, calculating it if necessary.
+
+const LevelOfDetail::Column& LevelOfDetail::column(const level_t& level, long long index,
+                                                   double width)
+{
+    if (m_cached_count > max_cached_columns) {
+        m_cache.clear();
+        m_cached_count = 0;
+    }
+
+    auto& columns = m_cache[level];
+    auto it = columns.find(index);
+    if (it != columns.end())
+        return it->second;
+
+    const auto& x = m_columns->axis;
+    const auto& y = m_columns->values;
+    const auto begin = static_cast<size_t>(
+        std::lower_bound(x.begin(), x.end(), index * width) - x.begin());
+    const auto end = static_cast<size_t>(
+        std::lower_bound(x.begin() + begin, x.end(), (index + 1) * width) - x.begin());
+
+    Column result;
+    if (begin < end) {
+        result.empty = false;
+        result.first = begin;
+        result.last = end - 1;
+        result.min = result.max = begin;
+        bool has_positive = !level.second || y[begin] > 0.0;
+        for (size_t i = begin; i < end; ++i) {
+            if (level.second && y[i] <= 0.0)
+                continue;
+            if (!has_positive) {
+                result.min = result.max = i;
+                has_positive = true;
+            }
+            if (y[i] < y[result.min])
+                result.min = i;
+            if (y[i] > y[result.max])
+                result.max = i;
+        }
+    }
+
+    ++m_cached_count;
+    return columns.emplace(index, result).first->second;
+}
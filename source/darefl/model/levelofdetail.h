@@ -0,0 +1,49 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#ifndef DAREFL_MODEL_LEVELOFDETAIL_H
+#define DAREFL_MODEL_LEVELOFDETAIL_H
+
+#include <darefl/model/experimentaldatastore.h>
+#include <map>
+#include <vector>
+
+//! Level-of-detail representation of the stored curve for plotting.
+//! The x-axis is split into columns of power-of-two width, not wider than a plot pixel column.
+//! For every column the first, the last, the minimum and the maximum points are kept.
+//! Columns are aligned to the same grid for any x-range, so they are cached per zoom level
+//! and only new columns are calculated on pan.
+
+class LevelOfDetail
+{
+public:
+    LevelOfDetail(ExperimentalDataStore::columns_t columns);
+
+    ExperimentalDataStore::columns_t columns() const;
+
+    std::vector<size_t> indices(double xmin, double xmax, int n_columns, bool log_scale);
+
+private:
+    struct Column {
+        size_t first{0};
+        size_t min{0};
+        size_t max{0};
+        size_t last{0};
+        bool empty{true};
+    };
+    using level_t = std::pair<int, bool>;
+
+    const Column& column(const level_t& level, long long index, double width);
+
+    ExperimentalDataStore::columns_t m_columns;
+    std::map<level_t, std::map<long long, Column>> m_cache; //! (zoom, log) -> columns
+    size_t m_cached_count{0};
+};
+
+#endif // DAREFL_MODEL_LEVELOFDETAIL_H
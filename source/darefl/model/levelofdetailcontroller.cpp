@@ -0,0 +1,125 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include <darefl/model/experimentaldatamodel.h>
+#include <darefl/model/levelofdetailcontroller.h>
+#include <limits>
+#include <mvvm/signals/itemmapper.h>
+#include <mvvm/signals/modelmapper.h>
+#include <mvvm/standarditems/axisitems.h>
+#include <mvvm/standarditems/data1ditem.h>
+#include <mvvm/standarditems/graphitem.h>
+#include <mvvm/standarditems/graphviewportitem.h>
+
+using namespace ModelView;
+
+LevelOfDetailController::LevelOfDetailController(std::function<int()> column_count)
+    : m_column_count(std::move(column_count))
+{
+}
+
+LevelOfDetailController::~LevelOfDetailController()
+{
+    unsubscribe();
+    if (m_data_model)
+        m_data_model->mapper()->unsubscribe(this);
+}
+
+void LevelOfDetailController::setViewport(GraphViewportItem* viewport)
+{
+    unsubscribe();
+
+    m_viewport = viewport;
+    if (!m_viewport)
+        return;
+
+    auto on_xaxis_change = [this](SessionItem*, std::string property_name) {
+        if (property_name == ViewportAxisItem::P_MIN || property_name == ViewportAxisItem::P_MAX)
+            update();
+    };
+    m_viewport->xAxis()->mapper()->setOnPropertyChange(on_xaxis_change, this);
+
+    auto on_yaxis_change = [this](SessionItem*, std::string property_name) {
+        if (property_name == ViewportAxisItem::P_IS_LOG)
+            update();
+    };
+    m_viewport->yAxis()->mapper()->setOnPropertyChange(on_yaxis_change, this);
+
+    auto on_item_destroy = [this](SessionItem*) { m_viewport = nullptr; };
+    m_viewport->mapper()->setOnItemDestroy(on_item_destroy, this);
+
+    update();
+}
+
+//! Sets the model keeping data items of viewport graphs. Changes of their source, other than
+//! updates of decimated views, lead to the update of decimated data.
+
+void LevelOfDetailController::setDataModel(ExperimentalDataModel* model)
+{
+    if (m_data_model)
+        m_data_model->mapper()->unsubscribe(this);
+
+    m_data_model = model;
+    if (!m_data_model)
+        return;
+
+    auto on_data_change = [this](SessionItem* item, int) {
+        if (dynamic_cast<Data1DItem*>(item) && !m_data_model->isViewUpdateInProgress())
+            update();
+    };
+    m_data_model->mapper()->setOnDataChange(on_data_change, this);
+
+    auto on_model_destroyed = [this](SessionModel*) { m_data_model = nullptr; };
+    m_data_model->mapper()->setOnModelDestroyed(on_model_destroyed, this);
+}
+
+//! Updates decimated data for the visible x-range.
+
+void LevelOfDetailController::update()
+{
+    if (!m_viewport)
+        return;
+
+    auto axis = m_viewport->xAxis();
+    update(axis->property<double>(ViewportAxisItem::P_MIN),
+           axis->property<double>(ViewportAxisItem::P_MAX));
+}
+
+//! Updates decimated data for the whole data range. Should be called before the viewport is
+//! adjusted to the data, so the viewport gets the range of data in full resolution.
+
+void LevelOfDetailController::resetRange()
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    update(-inf, inf);
+}
+
+void LevelOfDetailController::update(double xmin, double xmax)
+{
+    if (!m_viewport)
+        return;
+
+    const bool log_scale = m_viewport->yAxis()->property<bool>(ViewportAxisItem::P_IS_LOG);
+    for (auto graph : m_viewport->graphItems()) {
+        auto data = graph->dataItem();
+        auto model = data ? dynamic_cast<ExperimentalDataModel*>(data->model()) : nullptr;
+        if (model && model->isDecimated(data))
+            model->updateDataView(data, xmin, xmax, m_column_count(), log_scale);
+    }
+}
+
+void LevelOfDetailController::unsubscribe()
+{
+    if (!m_viewport)
+        return;
+
+    m_viewport->xAxis()->mapper()->unsubscribe(this);
+    m_viewport->yAxis()->mapper()->unsubscribe(this);
+    m_viewport->mapper()->unsubscribe(this);
+}
@@ -0,0 +1,49 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#ifndef DAREFL_MODEL_LEVELOFDETAILCONTROLLER_H
+#define DAREFL_MODEL_LEVELOFDETAILCONTROLLER_H
+
+#include <functional>
+
+namespace ModelView
+{
+class GraphViewportItem;
+}
+
+class ExperimentalDataModel;
+
+//! Keeps decimated data of viewport graphs in sync with the visible x-range and the scale of
+//! the y-axis. Only graphs with data in ExperimentalDataStore are affected. Used by plotting
+//! widgets as a rendering pre-stage, the number of plot columns is requested from the widget.
+//! Decimated data is also updated when the source of data items changes, e.g. when the stored data
+//! of an opened project arrives.
+
+class LevelOfDetailController
+{
+public:
+    LevelOfDetailController(std::function<int()> column_count);
+    ~LevelOfDetailController();
+
+    void setViewport(ModelView::GraphViewportItem* viewport);
+    void setDataModel(ExperimentalDataModel* model);
+
+    void update();
+    void resetRange();
+
+private:
+    void update(double xmin, double xmax);
+    void unsubscribe();
+
+    ModelView::GraphViewportItem* m_viewport{nullptr};
+    ExperimentalDataModel* m_data_model{nullptr};
+    std::function<int()> m_column_count;
+};
+
+#endif // DAREFL_MODEL_LEVELOFDETAILCONTROLLER_H
@@ -137,6 +137,8 @@ void MaterialModel::init_model()
     material = insertItem<SLDMaterialItem>(container);
     material->set_properties(substrate_material_name, suggestMaterialColor(substrate_material_name),
                              rho_si, mu_si);
+
+    setUndoRedoEnabled(true);
 }
 
 MaterialContainerItem* MaterialModel::materialContainer()
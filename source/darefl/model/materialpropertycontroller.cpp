@@ -8,34 +8,135 @@
 // ************************************************************************** //
 
 #include <darefl/model/layeritems.h>
+#include <darefl/model/materialitems.h>
 #include <darefl/model/materialmodel.h>
 #include <darefl/model/materialpropertycontroller.h>
 #include <darefl/model/samplemodel.h>
 #include <mvvm/model/externalproperty.h>
 #include <mvvm/model/modelutils.h>
+#include <mvvm/model/mvvm_types.h>
 
 using namespace ModelView;
 
+namespace
+{
+
+//! Returns material item containing given item, or nullptr.
+MaterialBaseItem* parent_material(SessionItem* item)
+{
+    while (item && !dynamic_cast<MaterialBaseItem*>(item))
+        item = item->parent();
+    return static_cast<MaterialBaseItem*>(item);
+}
+
+//! Sets the material property of the layer. Label updates of the same material aren't recorded by
+//! the undo stack, since they follow material edits and are rederived on their undo and redo.
+void set_material_property(LayerItem* layer, const ExternalProperty& updated)
+{
+    auto property = layer->property<ExternalProperty>(LayerItem::P_MATERIAL);
+    if (property == updated)
+        return;
+    const bool direct = property.identifier() == updated.identifier();
+    layer->getItem(LayerItem::P_MATERIAL)->setData(updated, ItemDataRole::DATA, direct);
+}
+
+} // namespace
+
 MaterialPropertyController::MaterialPropertyController(MaterialModel* material_model,
                                                        SampleModel* sample_model)
     : ModelListener(material_model), m_sample_model(sample_model)
 {
-    setOnDataChange([this](auto, auto) { update_all(); });
-    setOnItemInserted([this](auto, auto) { update_all(); });
-    setOnItemRemoved([this](auto, auto) { update_all(); });
+    setOnDataChange([this](auto item, auto) { update_material(item); });
+    setOnItemInserted([this](auto item, auto tagrow) {
+        update_material(item->getItem(tagrow.tag, tagrow.row));
+    });
+    setOnAboutToRemoveItem([this](auto item, auto tagrow) {
+        on_about_to_remove(item->getItem(tagrow.tag, tagrow.row));
+    });
+    setOnItemRemoved([this](auto, auto) { on_removed(); });
     setOnModelReset([this](auto) { update_all(); });
 
     update_all();
 }
 
-//! Updates all material properties in LayerItems to get new material colors and labels.
+//! Rebuilds the index of material properties and updates all material properties in LayerItems
+//! to get new material colors and labels.
 
 void MaterialPropertyController::update_all()
 {
+    m_properties.clear();
+    for (const auto& property : model()->material_data())
+        m_properties.emplace(property.identifier(), property);
+    m_index_outdated = false;
+
     for (auto layer : Utils::FindItems<LayerItem>(m_sample_model)) {
         auto property = layer->property<ExternalProperty>(LayerItem::P_MATERIAL);
-        auto updated = model()->material_property(property.identifier());
-        if (property != updated)
-            layer->setProperty(LayerItem::P_MATERIAL, updated);
+        auto it = m_properties.find(property.identifier());
+        set_material_property(layer,
+                              it == m_properties.end() ? ExternalProperty::undefined() : it->second);
     }
 }
+
+//! Updates the index entry of the material containing given item and the layers referring to it.
+//! Changes outside of materials (e.g. insertion of a whole container) lead to full update.
+
+void MaterialPropertyController::update_material(SessionItem* item)
+{
+    auto material = parent_material(item);
+    if (!material) {
+        update_all();
+        return;
+    }
+
+    if (material->parent() != Utils::TopItem<MaterialContainerItem>(model()))
+        return;
+
+    auto property = material->external_property();
+    auto it = m_properties.find(property.identifier());
+    if (it != m_properties.end() && it->second == property)
+        return;
+
+    m_properties[property.identifier()] = property;
+    update_layers({property.identifier()});
+}
+
+//! Updates material properties of layers referring to given material identifiers.
+
+void MaterialPropertyController::update_layers(const std::set<std::string>& ids)
+{
+    for (auto layer : Utils::FindItems<LayerItem>(m_sample_model)) {
+        auto property = layer->property<ExternalProperty>(LayerItem::P_MATERIAL);
+        if (ids.find(property.identifier()) == ids.end())
+            continue;
+        auto it = m_properties.find(property.identifier());
+        set_material_property(layer,
+                              it == m_properties.end() ? ExternalProperty::undefined() : it->second);
+    }
+}
+
+//! Remembers identifiers of materials which are going to disappear together with given item.
+
+void MaterialPropertyController::on_about_to_remove(SessionItem* item)
+{
+    if (auto material = dynamic_cast<MaterialBaseItem*>(item))
+        m_removed_ids.insert(material->identifier());
+    else if (!parent_material(item))
+        m_index_outdated = true;
+}
+
+//! Removes forgotten materials from the index and unlinks layers referring to them.
+
+void MaterialPropertyController::on_removed()
+{
+    if (m_index_outdated) {
+        m_removed_ids.clear();
+        update_all();
+        return;
+    }
+
+    auto ids = std::move(m_removed_ids);
+    m_removed_ids.clear();
+    for (const auto& id : ids)
+        m_properties.erase(id);
+    update_layers(ids);
+}
@@ -10,13 +10,18 @@
 #ifndef DAREFL_MODEL_MATERIALPROPERTYCONTROLLER_H
 #define DAREFL_MODEL_MATERIALPROPERTYCONTROLLER_H
 
+#include <map>
+#include <mvvm/model/externalproperty.h>
 #include <mvvm/model/sessionmodel.h>
 #include <mvvm/signals/modellistener.h>
+#include <set>
 
 class SampleModel;
 class MaterialModel;
 
 //! Listens for all changes in material model and updates properties in SampleModel.
+//! Keeps an index of material properties, so a single change updates only the layers
+//! referring to the changed material.
 
 class MaterialPropertyController : public ModelView::ModelListener<MaterialModel>
 {
@@ -25,8 +30,15 @@ public:
 
 private:
     void update_all();
+    void update_material(ModelView::SessionItem* item);
+    void update_layers(const std::set<std::string>& ids);
+    void on_about_to_remove(ModelView::SessionItem* item);
+    void on_removed();
 
     SampleModel* m_sample_model{nullptr};
+    std::map<std::string, ModelView::ExternalProperty> m_properties; //! material id -> property
+    std::set<std::string> m_removed_ids; //! materials which are about to be removed
+    bool m_index_outdated{false};        //! index has to be rebuilt on next removal
 };
 
 #endif // DAREFL_MODEL_MATERIALPROPERTYCONTROLLER_H
@@ -39,3 +39,35 @@ Utils::FindProperty(const std::vector<ModelView::ExternalProperty>& properties,
 
     return ModelView::ExternalProperty::undefined();
 }
+
+std::vector<double> Utils::SourceAxis(const ModelView::GraphItem* graph)
+{
+    auto data_model = dynamic_cast<const ExperimentalDataModel*>(graph->model());
+    if (data_model && graph->dataItem())
+        return data_model->sourceAxis(graph->dataItem());
+    return graph->binCenters();
+}
+
+std::vector<double> Utils::SourceValues(const ModelView::GraphItem* graph)
+{
+    auto data_model = dynamic_cast<const ExperimentalDataModel*>(graph->model());
+    if (data_model && graph->dataItem())
+        return data_model->sourceValues(graph->dataItem());
+    return graph->binValues();
+}
+
+std::vector<double> Utils::SourceErrors(const ModelView::GraphItem* graph)
+{
+    auto data_model = dynamic_cast<const ExperimentalDataModel*>(graph->model());
+    if (data_model && graph->dataItem())
+        return data_model->sourceErrors(graph->dataItem());
+    return {};
+}
+
+std::vector<double> Utils::SourceResolution(const ModelView::GraphItem* graph)
+{
+    auto data_model = dynamic_cast<const ExperimentalDataModel*>(graph->model());
+    if (data_model && graph->dataItem())
+        return data_model->sourceResolution(graph->dataItem());
+    return {};
+}
@@ -35,6 +35,18 @@ std::vector<ModelView::ExternalProperty> CreateGraphProperties(ExperimentalDataM
 ModelView::ExternalProperty FindProperty(const std::vector<ModelView::ExternalProperty>& properties,
                                          const std::string& id);
 
+//! Returns axis values of the graph in full resolution, even if the graph shows decimated data.
+std::vector<double> SourceAxis(const ModelView::GraphItem* graph);
+
+//! Returns values of the graph in full resolution, even if the graph shows decimated data.
+std::vector<double> SourceValues(const ModelView::GraphItem* graph);
+
+//! Returns uncertainties of the graph values, or empty vector if they are unknown.
+std::vector<double> SourceErrors(const ModelView::GraphItem* graph);
+
+//! Returns uncertainties of the graph axis values, or empty vector if they are unknown.
+std::vector<double> SourceResolution(const ModelView::GraphItem* graph);
+
 } // namespace Utils
 
 #endif // DAREFL_MODEL_MODELUTILS_H
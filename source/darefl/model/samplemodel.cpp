@@ -55,4 +55,6 @@ void SampleModel::create_default_multilayer()
 void SampleModel::init_model()
 {
     setItemCatalogue(CreateItemCatalogue());
+
+    setUndoRedoEnabled(true);
 }
@@ -0,0 +1,144 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include <algorithm>
+#include <cmath>
+#include <darefl/quicksimeditor/fieldintensity.h>
+#include <darefl/quicksimeditor/quicksimutils.h>
+#include <minikernel/Computation/Slice.h>
+#include <minikernel/MultiLayer/KzComputation.h>
+#include <minikernel/MultiLayer/SpecularScalarTanhStrategy.h>
+#include <thread>
+
+namespace
+{
+
+//! Number of consecutive points for which the exponents are propagated by multiplication with
+//! a constant step factor, before being evaluated exactly again. Prevents accumulation of rounding
+//! errors.
+const int exact_exp_period = 64;
+
+//! Precalculated location of the depth point in the multilayer. Doesn't depend on q.
+struct DepthPoint {
+    size_t slice{0};   //! index of the slice containing the point
+    double z{0.0};     //! depth relative to the top interface of the slice
+    double dz{0.0};    //! distance from the previous point
+    bool exact{true};  //! exponents at this point are evaluated exactly
+};
+
+//! Returns z-coordinates of top interfaces of all slices.
+std::vector<double> top_interfaces(const multislice_t& multislice)
+{
+    std::vector<double> result(multislice.size(), 0.0);
+    for (size_t i = 1; i < multislice.size(); ++i)
+        result[i] = result[i - 1] - multislice[i - 1].thickness;
+    return result;
+}
+
+//! Locates depth points in the multilayer and marks the points where the exponents have to be
+//! calculated exactly: first point in a slice, point after the change of the grid step and every
+//! exact_exp_period-th point.
+std::vector<DepthPoint> depth_points(const multislice_t& multislice,
+                                     const std::vector<double>& zvalues)
+{
+    auto z_top = top_interfaces(multislice);
+
+    std::vector<DepthPoint> result(zvalues.size());
+    int steps_since_exact{0};
+    for (size_t j = 0; j < zvalues.size(); ++j) {
+        auto& point = result[j];
+        // slice i occupies the region z_top[i+1] < z <= z_top[i]
+        size_t slice = 0;
+        while (slice + 1 < z_top.size() && zvalues[j] <= z_top[slice + 1])
+            ++slice;
+        point.slice = slice;
+        point.z = zvalues[j] - z_top[slice];
+
+        if (j == 0 || result[j - 1].slice != slice || steps_since_exact >= exact_exp_period) {
+            point.exact = true;
+        } else {
+            point.dz = point.z - result[j - 1].z;
+            const bool is_same_step =
+                !result[j - 1].exact
+                && std::abs(point.dz - result[j - 1].dz) <= 1e-9 * std::abs(point.dz);
+            point.exact = !result[j - 1].exact && !is_same_step;
+        }
+        steps_since_exact = point.exact ? 0 : steps_since_exact + 1;
+    }
+    return result;
+}
+
+//! Calculates field intensity for the given range of q values.
+void calculate_range(const std::vector<BornAgain::Slice>& slices,
+                     const std::vector<double>& qvalues, const std::vector<DepthPoint>& points,
+                     size_t iq_begin, size_t iq_end, std::vector<double>& result)
+{
+    SpecularScalarTanhStrategy strategy;
+    std::vector<Eigen::Vector2cd> t_r;
+    const size_t nz = points.size();
+
+    for (size_t iq = iq_begin; iq < iq_end; ++iq) {
+        auto kz = KzComputation::computeKzFromSLDs(slices, -0.5 * qvalues[iq]);
+        strategy.computeAmplitudes(slices, kz, t_r);
+
+        // transmitted wave propagates as exp(-i kz z), reflected as exp(i kz z)
+        complex_t exp_down, exp_up, step_down, step_up;
+        double* row = &result[iq * nz];
+        for (size_t j = 0; j < nz; ++j) {
+            const auto& point = points[j];
+            const complex_t kz_slice = kz[point.slice];
+            if (point.exact) {
+                exp_down = exp_I(-kz_slice * point.z);
+                exp_up = exp_I(kz_slice * point.z);
+            } else {
+                if (points[j - 1].exact) {
+                    step_down = exp_I(-kz_slice * point.dz);
+                    step_up = exp_I(kz_slice * point.dz);
+                }
+                exp_down *= step_down;
+                exp_up *= step_up;
+            }
+            const auto& amplitudes = t_r[point.slice];
+            row[j] = std::norm(amplitudes(0) * exp_down + amplitudes(1) * exp_up);
+        }
+    }
+}
+
+} // namespace
+
+std::vector<double> FieldIntensity::Calculate(const multislice_t& multislice,
+                                              const std::vector<double>& qvalues,
+                                              const std::vector<double>& zvalues, int n_threads)
+{
+    std::vector<double> result(qvalues.size() * zvalues.size(), 0.0);
+    if (multislice.empty() || result.empty())
+        return result;
+
+    const auto slices = ::Utils::createBornAgainSlices(multislice);
+    const auto points = depth_points(multislice, zvalues);
+
+    if (n_threads <= 0)
+        n_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const size_t n_chunks = std::min(static_cast<size_t>(n_threads), qvalues.size());
+    const size_t chunk_size = (qvalues.size() + n_chunks - 1) / n_chunks;
+
+    std::vector<std::thread> threads;
+    for (size_t iq_begin = chunk_size; iq_begin < qvalues.size(); iq_begin += chunk_size) {
+        const size_t iq_end = std::min(iq_begin + chunk_size, qvalues.size());
+        threads.emplace_back(calculate_range, std::cref(slices), std::cref(qvalues),
+                             std::cref(points), iq_begin, iq_end, std::ref(result));
+    }
+    // first chunk is calculated in the calling thread
+    calculate_range(slices, qvalues, points, 0, std::min(chunk_size, qvalues.size()), result);
+
+    for (auto& thread : threads)
+        thread.join();
+
+    return result;
+}
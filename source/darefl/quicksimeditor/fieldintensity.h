@@ -0,0 +1,30 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#ifndef DAREFL_QUICKSIMEDITOR_FIELDINTENSITY_H
+#define DAREFL_QUICKSIMEDITOR_FIELDINTENSITY_H
+
+#include <darefl/quicksimeditor/quicksim_types.h>
+
+//! Collection of methods to calculate the intensity of the standing wave field inside
+//! the multilayer.
+
+namespace FieldIntensity
+{
+
+//! Calculates field intensity |psi(z, q)|^2 on a grid of depth and q values. Depth z is counted
+//! from the sample surface, negative values correspond to points inside the sample. The result is
+//! ordered with z being the fastest running index: result[iq * zvalues.size() + iz].
+//! Calculation is split over q values between `n_threads` threads (0 - hardware concurrency).
+std::vector<double> Calculate(const multislice_t& multislice, const std::vector<double>& qvalues,
+                              const std::vector<double>& zvalues, int n_threads = 0);
+
+} // namespace FieldIntensity
+
+#endif // DAREFL_QUICKSIMEDITOR_FIELDINTENSITY_H
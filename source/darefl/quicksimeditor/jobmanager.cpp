@@ -8,8 +8,14 @@
 // ************************************************************************** //
 
 #include <darefl/quicksimeditor/jobmanager.h>
+#include <darefl/quicksimeditor/simulationresultcache.h>
+#include <darefl/settingsview/constants.h>
 
-JobManager::JobManager(QObject* parent) : QObject(parent), m_is_running(true)
+JobManager::JobManager(QObject* parent)
+    : QObject(parent),
+      m_result_cache(
+          std::make_unique<SimulationResultCache>(Constants::simulation_cache_memory_budget)),
+      m_is_running(true)
 {
     // starting thread to run consequent simulations
     m_sim_thread = std::thread{&JobManager::wait_and_run, this};
@@ -30,19 +36,34 @@ SpecularToySimulation::Result JobManager::simulationResult()
     return result ? *result.get() : SpecularToySimulation::Result();
 }
 
-//! Performs simulation request. Given multislice will be stored in a stack of values to trigger
-//! a waiting thread.
+//! Performs simulation request. If the result for identical input is already known, it is
+//! reported immediately. Otherwise, given multislice will be stored in a stack of values to
+//! trigger a waiting thread.
 
 void JobManager::requestSimulation(const multislice_t& multislice,
-                                   const std::vector<double>& qvalues, double intensity)
+                                   const std::vector<double>& qvalues, double intensity,
+                                   const std::vector<double>& zvalues,
+                                   const std::vector<double>& qresolution)
 {
+    Request request;
+    request.request_id = ++m_request_count;
+    request.input_data.slice_data = multislice;
+    request.input_data.qvalues = qvalues;
+    request.input_data.intensity = intensity;
+    request.input_data.zvalues = zvalues;
+    request.input_data.qresolution = qresolution;
+
+    if (auto result = m_result_cache->find(request.input_data); result) {
+        // Results of all earlier requests are outdated now, dropping the one waiting in a stack.
+        m_requested_values.try_pop();
+        publish_result(request.request_id, *result);
+        simulationCompleted();
+        return;
+    }
+
     // At this point, non-empty stack means that currently simulation thread is busy.
     // Replacing top value in a stack, meaning that we are droping previous request.
-    SpecularToySimulation::InputData input_data;
-    input_data.slice_data = multislice;
-    input_data.qvalues = qvalues;
-    input_data.intensity = intensity;
-    m_requested_values.update_top(input_data);
+    m_requested_values.update_top(request);
 }
 
 //! Processes interrupt request by setting corresponding flag.
@@ -61,10 +82,10 @@ void JobManager::wait_and_run()
     while (m_is_running) {
         try {
             // Waiting here for the value which we will use as simulation input parameter.
-            auto value = m_requested_values.wait_and_pop();
+            auto request = m_requested_values.wait_and_pop();
 
             // preparing simulation
-            SpecularToySimulation simulation(*value.get());
+            SpecularToySimulation simulation(request->input_data);
             auto on_progress = [this](int value) {
                 progressChanged(value);
                 return m_interrupt_request;
@@ -73,11 +94,11 @@ void JobManager::wait_and_run()
 
             // running simulation
             simulation.runSimulation();
+            m_result_cache->insert(request->input_data, simulation.simulationResult());
 
-            // Saving simulation result, overwrite previous if exists. If at this point stack
-            // with results is not empty it means that plotting is disabled or running too slow.
-            m_simulation_results.update_top(simulation.simulationResult());
-            simulationCompleted();
+            // Result is dropped if newer request was served from the cache meanwhile.
+            if (publish_result(request->request_id, simulation.simulationResult()))
+                simulationCompleted();
 
         } catch (std::exception ex) {
             // Exception is thrown
@@ -88,3 +109,17 @@ void JobManager::wait_and_run()
         }
     }
 }
+
+//! Saves the result of the request, overwrite previous if exists. If at this point stack with
+//! results is not empty it means that plotting is disabled or running too slow. Returns false
+//! if the result is outdated, because the result of a newer request was saved already.
+
+bool JobManager::publish_result(size_t request_id, const SpecularToySimulation::Result& result)
+{
+    std::lock_guard<std::mutex> lock(m_result_mutex);
+    if (request_id < m_last_published_request)
+        return false;
+    m_last_published_request = request_id;
+    m_simulation_results.update_top(result);
+    return true;
+}
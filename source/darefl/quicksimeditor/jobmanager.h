@@ -12,8 +12,12 @@
 
 #include <QObject>
 #include <darefl/quicksimeditor/speculartoysimulation.h>
+#include <memory>
+#include <mutex>
 #include <mvvm/utils/threadsafestack.h>
 
+class SimulationResultCache;
+
 //! Handles all thread activity for running job simulation in the background.
 
 class JobManager : public QObject
@@ -31,16 +35,28 @@ signals:
 
 public slots:
     void requestSimulation(const multislice_t& multislice, const std::vector<double>& qvalues,
-                           double intensity);
+                           double intensity, const std::vector<double>& zvalues = {},
+                           const std::vector<double>& qresolution = {});
     void onInterruptRequest();
 
 private:
+    //! Simulation request waiting for the simulation thread.
+    struct Request {
+        size_t request_id{0};
+        SpecularToySimulation::InputData input_data;
+    };
+
     void wait_and_run();
+    bool publish_result(size_t request_id, const SpecularToySimulation::Result& result);
 
     std::thread m_sim_thread;
-    ModelView::threadsafe_stack<SpecularToySimulation::InputData> m_requested_values;
+    ModelView::threadsafe_stack<Request> m_requested_values;
     ModelView::threadsafe_stack<SpecularToySimulation::Result> m_simulation_results;
+    std::unique_ptr<SimulationResultCache> m_result_cache;
     std::atomic<bool> m_is_running;
+    std::atomic<size_t> m_request_count{0}; //! Number of requests made so far.
+    std::mutex m_result_mutex;              //! Serializes publishing of results.
+    size_t m_last_published_request{0};     //! Id of the request with the last published result.
     bool m_interrupt_request{false};
 };
 
@@ -8,6 +8,7 @@
 // ************************************************************************** //
 
 #include <darefl/model/applicationmodels.h>
+#include <darefl/model/experimentaldatamodel.h>
 #include <darefl/model/instrumentitems.h>
 #include <darefl/model/instrumentmodel.h>
 #include <darefl/model/jobitem.h>
@@ -21,14 +22,18 @@
 #include <darefl/quicksimeditor/quicksimutils.h>
 #include <darefl/settingsview/constants.h>
 #include <mvvm/project/modelhaschangedcontroller.h>
+#include <mvvm/signals/modellistener.h>
 #include <mvvm/standarditems/axisitems.h>
+#include <mvvm/standarditems/colormapviewportitem.h>
 #include <mvvm/standarditems/data1ditem.h>
+#include <mvvm/standarditems/data2ditem.h>
 #include <mvvm/standarditems/graphviewportitem.h>
 
 namespace
 {
 const int profile_points_count = 1000;
-}
+const int field_depth_points_count = 200;
+} // namespace
 
 QuickSimController::QuickSimController(QObject* parent)
     : QObject(parent), job_manager(new JobManager(this)),
@@ -50,6 +55,15 @@ void QuickSimController::setModels(ApplicationModels* models)
     m_instrumentChangedController = std::make_unique<ModelView::ModelHasChangedController>(
         m_models->instrumentModel(), on_model_change);
 
+    // updates of decimated views don't change the scan
+    auto data_model = m_models->experimentalDataModel();
+    m_dataChangedListener =
+        std::make_unique<ModelView::ModelListener<ExperimentalDataModel>>(data_model);
+    m_dataChangedListener->setOnDataChange([this, data_model](auto item, auto) {
+        if (dynamic_cast<ModelView::Data1DItem*>(item) && !data_model->isViewUpdateInProgress())
+            onMultiLayerChange();
+    });
+
     setup_jobmanager_connections();
 
     onMultiLayerChange();
@@ -75,6 +89,15 @@ void QuickSimController::onRunSimulationRequest()
     process_multilayer(/*submit_simulation*/ true);
 }
 
+//! Switches calculation of the wave field intensity inside the sample on and off. Simulation is
+//! resubmitted when running in real time mode.
+
+void QuickSimController::onFieldIntensityRequest(bool status)
+{
+    m_field_intensity_on = status;
+    process_multilayer(/*submit_simulation*/ in_realtime_mode);
+}
+
 //! Processes multilayer on any model change. Works only in realtime mode.
 
 void QuickSimController::onMultiLayerChange()
@@ -86,10 +109,25 @@ void QuickSimController::onMultiLayerChange()
 
 void QuickSimController::onSimulationCompleted()
 {
-    auto [qvalues, amplitudes] = job_manager->simulationResult();
+    auto result = job_manager->simulationResult();
     auto data = jobModel()->specular_data();
-    data->setAxis(ModelView::PointwiseAxisItem::create(qvalues));
-    data->setContent(amplitudes);
+    data->setAxis(ModelView::PointwiseAxisItem::create(result.qvalues));
+    data->setContent(result.amplitudes);
+
+    if (!result.field_intensity.empty()) {
+        // depth values are equidistant bin centers, axis is defined by the outer bin edges
+        const auto& zvalues = result.zvalues;
+        const double half_step =
+            zvalues.size() > 1 ? (zvalues.back() - zvalues.front()) / (zvalues.size() - 1) / 2
+                               : 0.5;
+        auto field_data = jobModel()->field_data();
+        field_data->setAxes(ModelView::FixedBinAxisItem::create(zvalues.size(),
+                                                                zvalues.front() - half_step,
+                                                                zvalues.back() + half_step),
+                            ModelView::PointwiseAxisItem::create(result.qvalues));
+        field_data->setContent(result.field_intensity);
+        jobModel()->field_viewport()->update_viewport();
+    }
 }
 
 //! Constructs multislice, calculates profile and submits specular simulation.
@@ -115,12 +153,19 @@ void QuickSimController::update_sld_profile(const multislice_t& multislice)
 }
 
 //! Submit data to JobManager for consequent specular simulation in a separate thread.
+//! Results of already simulated configurations (i.e. on undo/redo) are served from the cache.
 
 void QuickSimController::submit_specular_simulation(const multislice_t& multislice)
 {
     auto instrument = instrumentModel()->topItem<SpecularInstrumentItem>();
     auto beam = instrument->beamItem();
-    job_manager->requestSimulation(multislice, beam->qScanValues(), beam->intensity());
+    std::vector<double> zvalues;
+    if (m_field_intensity_on) {
+        auto [zmin, zmax] = MaterialProfile::DefaultMaterialProfileLimits(multislice);
+        zvalues = MaterialProfile::GenerateZValues(field_depth_points_count, zmin, zmax);
+    }
+    job_manager->requestSimulation(multislice, beam->qScanValues(), beam->intensity(), zvalues,
+                                   beam->qScanResolution());
 }
 
 //! Connect signals going from JobManager. Connections are made queued since signals are emitted
@@ -17,9 +17,11 @@
 namespace ModelView
 {
 class ModelHasChangedController;
-}
+template <typename T> class ModelListener;
+} // namespace ModelView
 
 class ApplicationModels;
+class ExperimentalDataModel;
 class JobManager;
 class JobModel;
 class InstrumentModel;
@@ -28,6 +30,7 @@ class InstrumentModel;
 //! Listens for any change in SampleModel and MaterialModel, extracts the data needed for
 //! the simulation, and then submit simulation request to JobManager. As soon as JobManager reports
 //! about completed simulations, extract results from there and put them into JobModel.
+//! Changes of the source of experimental data, which the scan may be based on, are followed too.
 
 class QuickSimController : public QObject
 {
@@ -45,6 +48,7 @@ public slots:
     void onInterruptRequest();
     void onRealTimeRequest(bool status);
     void onRunSimulationRequest();
+    void onFieldIntensityRequest(bool status);
 
 private slots:
     void onMultiLayerChange();
@@ -63,10 +67,12 @@ private:
     JobManager* job_manager{nullptr};
 
     bool in_realtime_mode; //! Run simulation on every parameter change.
+    bool m_field_intensity_on{false}; //! Calculate field intensity map along with reflectivity.
 
     std::unique_ptr<ModelView::ModelHasChangedController> m_materialChangedController;
     std::unique_ptr<ModelView::ModelHasChangedController> m_sampleChangedController;
     std::unique_ptr<ModelView::ModelHasChangedController> m_instrumentChangedController;
+    std::unique_ptr<ModelView::ModelListener<ExperimentalDataModel>> m_dataChangedListener;
 };
 
 #endif // DAREFL_QUICKSIMEDITOR_QUICKSIMCONTROLLER_H
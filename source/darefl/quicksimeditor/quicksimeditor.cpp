@@ -84,6 +84,14 @@ void QuickSimEditor::setup_toolbar_connections()
     connect(dynamic_cast<QuickSimEditorToolBar*>(p_toolbar),
             &QuickSimEditorToolBar::runSimulationRequest, sim_controller,
             &QuickSimController::onRunSimulationRequest);
+
+    // Request for field intensity map is propagated from toolbar to controller and plot widget.
+    auto on_field_request = [this](bool value) {
+        m_plotWidget->setFieldMapVisible(value);
+        sim_controller->onFieldIntensityRequest(value);
+    };
+    connect(dynamic_cast<QuickSimEditorToolBar*>(p_toolbar),
+            &QuickSimEditorToolBar::fieldIntensityRequest, on_field_request);
 }
 
 //! Connects signals from controller.
@@ -28,7 +28,7 @@
 
 QuickSimEditorToolBar::QuickSimEditorToolBar(QWidget* parent)
     : EditorToolBar("Simulation", parent), live_checkbox(new QCheckBox),
-      progressbar(new QProgressBar)
+      field_checkbox(new QCheckBox), progressbar(new QProgressBar)
 {
     const int toolbar_icon_size = 24;
     setIconSize(QSize(toolbar_icon_size, toolbar_icon_size));
@@ -100,4 +100,15 @@ void QuickSimEditorToolBar::setup_plot_elements()
     reset_view->setIcon(QIcon(":/icons/aspect-ratio.svg"));
     connect(reset_view, &QAction::triggered, this, &QuickSimEditorToolBar::resetViewRequest);
     addAction(reset_view);
+
+    // field intensity map check box and label
+    const QString field_tooltip = "Calculate intensity of the wave field inside the sample\n"
+                                  "as a function of depth and q.";
+    field_checkbox->setToolTip(field_tooltip);
+    auto on_check_state = [this](int state) { fieldIntensityRequest(state == Qt::Checked); };
+    connect(field_checkbox, &QCheckBox::stateChanged, on_check_state);
+    addWidget(field_checkbox);
+    auto label = new QLabel("Field map");
+    label->setToolTip(field_tooltip);
+    addWidget(label);
 }
@@ -34,6 +34,7 @@ signals:
     void instrumentSettingsRequest();
     void resetViewRequest();
     void plotSettingsRequest();
+    void fieldIntensityRequest(bool);
 
 public slots:
     void onProgressChanged(int value);
@@ -44,6 +45,7 @@ private:
     void setup_plot_elements();
 
     QCheckBox* live_checkbox{nullptr};
+    QCheckBox* field_checkbox{nullptr};
     QProgressBar* progressbar{nullptr}; //! Simulation progressbar.
 };
 
@@ -12,15 +12,21 @@
 #include <QVBoxLayout>
 #include <darefl/model/applicationmodels.h>
 #include <darefl/model/experimentaldataitems.h>
+#include <darefl/model/experimentaldatamodel.h>
 #include <darefl/model/jobitem.h>
 #include <darefl/model/jobmodel.h>
+#include <darefl/model/levelofdetailcontroller.h>
 #include <darefl/quicksimeditor/simplotwidget.h>
+#include <mvvm/plotting/colormapcanvas.h>
 #include <mvvm/plotting/graphcanvas.h>
+#include <mvvm/standarditems/colormapviewportitem.h>
 #include <mvvm/standarditems/graphviewportitem.h>
 
 SimPlotWidget::SimPlotWidget(QWidget* parent)
     : QWidget(parent), m_specularCanvas(new ModelView::GraphCanvas),
-      m_diffCanvas(new ModelView::GraphCanvas)
+      m_diffCanvas(new ModelView::GraphCanvas), m_fieldCanvas(new ModelView::ColorMapCanvas),
+      m_lodController(
+          std::make_unique<LevelOfDetailController>([this]() { return m_specularCanvas->width(); }))
 {
     auto layout = new QVBoxLayout(this);
     layout->setContentsMargins(0, 5, 5, 5);
@@ -30,9 +36,11 @@ SimPlotWidget::SimPlotWidget(QWidget* parent)
 
     splitter->addWidget(m_specularCanvas);
     splitter->addWidget(m_diffCanvas);
+    splitter->addWidget(m_fieldCanvas);
+    m_fieldCanvas->hide();
 
     //    splitter->setStyleSheet("background-color:white;");
-    splitter->setSizes(QList<int>() << 300 << 100);
+    splitter->setSizes(QList<int>() << 300 << 100 << 300);
 
     layout->addWidget(splitter);
 }
@@ -41,10 +49,31 @@ void SimPlotWidget::setModels(ApplicationModels* models)
 {
     m_models = models;
 
+    m_lodController->setDataModel(m_models->experimentalDataModel());
+    m_lodController->setViewport(m_models->jobModel()->specular_viewport());
     m_specularCanvas->setItem(m_models->jobModel()->specular_viewport());
+    m_fieldCanvas->setItem(m_models->jobModel()->field_viewport());
 }
 
+SimPlotWidget::~SimPlotWidget() = default;
+
 void SimPlotWidget::update_viewport()
 {
+    m_lodController->resetRange();
     m_specularCanvas->update_viewport();
 }
+
+//! Shows or hides canvas with the field intensity map.
+
+void SimPlotWidget::setFieldMapVisible(bool value)
+{
+    m_fieldCanvas->setVisible(value);
+}
+
+//! Reference data could be decimated by other canvas showing the same graph.
+
+void SimPlotWidget::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    m_lodController->update();
+}
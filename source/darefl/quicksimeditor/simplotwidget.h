@@ -11,13 +11,16 @@
 #define DAREFL_QUICKSIMEDITOR_SIMPLOTWIDGET_H
 
 #include <QWidget>
+#include <memory>
 
 namespace ModelView
 {
+class ColorMapCanvas;
 class GraphCanvas;
-}
+} // namespace ModelView
 
 class ApplicationModels;
+class LevelOfDetailController;
 
 //! Presents simulation results together with reference experimental data on two canvas.
 //! The top canvas contains graphs itself, bottom canvas their relative difference.
@@ -27,15 +30,23 @@ class SimPlotWidget : public QWidget
     Q_OBJECT
 public:
     SimPlotWidget(QWidget* parent = nullptr);
+    ~SimPlotWidget() override;
 
     void setModels(ApplicationModels* models);
 
     void update_viewport();
 
+    void setFieldMapVisible(bool value);
+
+protected:
+    void showEvent(QShowEvent* event) override;
+
 private:
     ApplicationModels* m_models{nullptr};
     ModelView::GraphCanvas* m_specularCanvas{nullptr};
     ModelView::GraphCanvas* m_diffCanvas{nullptr};
+    ModelView::ColorMapCanvas* m_fieldCanvas{nullptr}; //! Field intensity inside the sample.
+    std::unique_ptr<LevelOfDetailController> m_lodController;
 };
 
 #endif // DAREFL_QUICKSIMEDITOR_SIMPLOTWIDGET_H
@@ -0,0 +1,181 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include <cstdint>
+#include <cstring>
+#include <darefl/quicksimeditor/simulationresultcache.h>
+
+namespace
+{
+
+//! FNV-1a hash accumulation over the bit pattern of a double.
+void hash_combine(uint64_t& seed, double value)
+{
+    const uint64_t fnv_prime = 1099511628211ULL;
+    if (value == 0.0)
+        value = 0.0; // +0.0 and -0.0 should give the same hash
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; ++i) {
+        seed ^= (bits >> (8 * i)) & 0xff;
+        seed *= fnv_prime;
+    }
+}
+
+bool is_same_input(const SimulationResultCache::input_t& lhs,
+                   const SimulationResultCache::input_t& rhs)
+{
+    if (lhs.intensity != rhs.intensity || lhs.qvalues != rhs.qvalues
+        || lhs.zvalues != rhs.zvalues || lhs.qresolution != rhs.qresolution
+        || lhs.slice_data.size() != rhs.slice_data.size())
+        return false;
+
+    for (size_t i = 0; i < lhs.slice_data.size(); ++i) {
+        const auto& left = lhs.slice_data[i];
+        const auto& right = rhs.slice_data[i];
+        if (left.material != right.material || left.thickness != right.thickness
+            || left.sigma != right.sigma)
+            return false;
+    }
+    return true;
+}
+
+//! Returns approximate amount of memory occupied by the cache entry.
+size_t memory_footprint(const SimulationResultCache::input_t& input,
+                        const SimulationResultCache::result_t& result)
+{
+    return sizeof(input) + sizeof(result)
+           + sizeof(double)
+                 * (input.qvalues.size() + input.zvalues.size() + input.qresolution.size()
+                    + result.qvalues.size() + result.amplitudes.size() + result.zvalues.size()
+                    + result.field_intensity.size())
+           + sizeof(Slice) * input.slice_data.size();
+}
+
+} // namespace
+
+SimulationResultCache::SimulationResultCache(size_t memory_budget) : m_memory_budget(memory_budget)
+{
+}
+
+//! Returns cached result for given simulation input, if exists. Marks found entry as the most
+//! recently used.
+
+std::optional<SimulationResultCache::result_t> SimulationResultCache::find(const input_t& input)
+{
+    const size_t key = hash(input);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(key);
+    if (it == m_index.end() || !is_same_input(it->second->input, input))
+        return {};
+
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return m_entries.front().result;
+}
+
+//! Puts simulation result in the cache. Least recently used entries will be removed if memory
+//! budget is exceeded.
+
+void SimulationResultCache::insert(const input_t& input, const result_t& result)
+{
+    const size_t key = hash(input);
+    const size_t bytes = memory_footprint(input, result);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (bytes > m_memory_budget)
+        return;
+
+    // replacing existing entry, or entry with colliding hash
+    if (auto it = m_index.find(key); it != m_index.end())
+        erase(it->second);
+
+    m_entries.push_front({key, input, result, bytes});
+    m_index[key] = m_entries.begin();
+    m_memory_usage += bytes;
+
+    shrink_to_budget();
+}
+
+void SimulationResultCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_index.clear();
+    m_memory_usage = 0;
+}
+
+//! Returns number of cached results.
+
+size_t SimulationResultCache::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+//! Returns approximate amount of memory (in bytes) occupied by cached results.
+
+size_t SimulationResultCache::memoryUsage() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_memory_usage;
+}
+
+size_t SimulationResultCache::memoryBudget() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_memory_budget;
+}
+
+void SimulationResultCache::setMemoryBudget(size_t memory_budget)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_memory_budget = memory_budget;
+    shrink_to_budget();
+}
+
+//! Returns hash of simulation input.
+
+size_t SimulationResultCache::hash(const input_t& input)
+{
+    uint64_t result = 14695981039346656037ULL; // FNV offset basis
+    hash_combine(result, static_cast<double>(input.slice_data.size()));
+    for (const auto& slice : input.slice_data) {
+        hash_combine(result, slice.material.real());
+        hash_combine(result, slice.material.imag());
+        hash_combine(result, slice.thickness);
+        hash_combine(result, slice.sigma);
+    }
+    hash_combine(result, static_cast<double>(input.qvalues.size()));
+    for (auto q : input.qvalues)
+        hash_combine(result, q);
+    hash_combine(result, input.intensity);
+    hash_combine(result, static_cast<double>(input.zvalues.size()));
+    for (auto z : input.zvalues)
+        hash_combine(result, z);
+    hash_combine(result, static_cast<double>(input.qresolution.size()));
+    for (auto dq : input.qresolution)
+        hash_combine(result, dq);
+    return static_cast<size_t>(result);
+}
+
+//! Removes least recently used entries until memory usage fits into the budget.
+
+void SimulationResultCache::shrink_to_budget()
+{
+    while (m_memory_usage > m_memory_budget && !m_entries.empty())
+        erase(std::prev(m_entries.end()));
+}
+
+void SimulationResultCache::erase(entries_t::iterator it)
+{
+    m_memory_usage -= it->bytes;
+    m_index.erase(it->key);
+    m_entries.erase(it);
+}
@@ -0,0 +1,66 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#ifndef DAREFL_QUICKSIMEDITOR_SIMULATIONRESULTCACHE_H
+#define DAREFL_QUICKSIMEDITOR_SIMULATIONRESULTCACHE_H
+
+#include <darefl/quicksimeditor/speculartoysimulation.h>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+//! Content-addressed LRU cache of specular simulation results.
+//! Results are keyed by the hash of simulation input (multislice, q-values and intensity).
+//! Least recently used results are dropped as soon as the memory occupied by the cache exceeds
+//! the budget. Thread-safe, used by JobManager from both GUI and simulation threads.
+
+class SimulationResultCache
+{
+public:
+    using input_t = SpecularToySimulation::InputData;
+    using result_t = SpecularToySimulation::Result;
+
+    SimulationResultCache(size_t memory_budget);
+
+    std::optional<result_t> find(const input_t& input);
+
+    void insert(const input_t& input, const result_t& result);
+
+    void clear();
+
+    size_t size() const;
+
+    size_t memoryUsage() const;
+
+    size_t memoryBudget() const;
+    void setMemoryBudget(size_t memory_budget);
+
+    static size_t hash(const input_t& input);
+
+private:
+    struct Entry {
+        size_t key;
+        input_t input;
+        result_t result;
+        size_t bytes;
+    };
+    using entries_t = std::list<Entry>;
+
+    void shrink_to_budget();
+    void erase(entries_t::iterator it);
+
+    mutable std::mutex m_mutex;
+    entries_t m_entries; //! Most recently used entries come first.
+    std::unordered_map<size_t, entries_t::iterator> m_index;
+    size_t m_memory_budget{0};
+    size_t m_memory_usage{0};
+};
+
+#endif // DAREFL_QUICKSIMEDITOR_SIMULATIONRESULTCACHE_H
@@ -8,6 +8,7 @@
 // ************************************************************************** //
 
 #include <algorithm>
+#include <darefl/quicksimeditor/fieldintensity.h>
 #include <darefl/quicksimeditor/materialprofile.h>
 #include <darefl/quicksimeditor/quicksimutils.h>
 #include <darefl/quicksimeditor/speculartoysimulation.h>
@@ -20,33 +21,83 @@
 
 using namespace ModelView;
 
+namespace
+{
+
+//! Nodes and weights of Gauss-Hermite quadrature averaging over the standard normal distribution.
+const std::vector<std::pair<double, double>> smearing_quadrature = {
+    {-2.8569700138728056, 0.011257411327720689},
+    {-1.3556261799742659, 0.2220759220056126},
+    {0.0, 0.5333333333333333},
+    {1.3556261799742659, 0.2220759220056126},
+    {2.8569700138728056, 0.011257411327720689}};
+
+} // namespace
+
 SpecularToySimulation::~SpecularToySimulation() = default;
 
 SpecularToySimulation::SpecularToySimulation(const InputData& input_data)
     : m_inputData(input_data), m_strategy(std::make_unique<SpecularScalarTanhStrategy>())
 {
+    if (!m_inputData.qresolution.empty()
+        && m_inputData.qresolution.size() != m_inputData.qvalues.size())
+        throw std::runtime_error("Error in SpecularToySimulation: wrong size of q-resolution.");
 }
 
+//! Runs the simulation. With the q-resolution given, the reflectivity at every q-value is averaged
+//! over the normal distribution of q around it.
+
 void SpecularToySimulation::runSimulation()
 {
     auto slices = ::Utils::createBornAgainSlices(m_inputData.slice_data);
 
-    m_specularResult.amplitudes.reserve(scanPointsCount());
+    // kz values for the whole scan, including the points of resolution smearing, are computed
+    // in one go
+    const bool is_smeared = !m_inputData.qresolution.empty();
+    std::vector<double> kz_values;
+    kz_values.reserve(scanPointsCount());
+    for (size_t i = 0; i < m_inputData.qvalues.size(); ++i) {
+        const double q = m_inputData.qvalues[i];
+        if (!is_smeared) {
+            kz_values.push_back(-0.5 * q);
+            continue;
+        }
+        for (auto [node, weight] : smearing_quadrature)
+            kz_values.push_back(-0.5 * std::abs(q + node * m_inputData.qresolution[i]));
+    }
+    auto kz_matrix = KzComputation::computeKzFromSLDs(slices, kz_values);
 
     m_progressHandler.reset();
-    for (auto q : m_inputData.qvalues) {
+    std::vector<double> reflectivity;
+    reflectivity.reserve(scanPointsCount());
+    for (const auto& kzs : kz_matrix) {
         if (m_progressHandler.has_interrupt_request())
             throw std::runtime_error("Interrupt request");
 
-        auto kz = -0.5 * q;
-        auto kzs = KzComputation::computeKzFromSLDs(slices, kz);
-        auto coeff = std::move(m_strategy->Execute(slices, kzs).front());
-        auto amplitude = std::norm(coeff->getScalarR()) * m_inputData.intensity;
-        m_specularResult.amplitudes.emplace_back(amplitude);
+        reflectivity.emplace_back(std::norm(m_strategy->topLayerR(slices, kzs)));
 
         m_progressHandler.setCompletedTicks(1);
     }
+
+    m_specularResult.amplitudes.clear();
+    m_specularResult.amplitudes.reserve(m_inputData.qvalues.size());
+    const size_t n_nodes = is_smeared ? smearing_quadrature.size() : 1;
+    for (size_t i = 0; i < m_inputData.qvalues.size(); ++i) {
+        double value = reflectivity[i * n_nodes];
+        if (is_smeared) {
+            value = 0.0;
+            for (size_t node = 0; node < n_nodes; ++node)
+                value += smearing_quadrature[node].second * reflectivity[i * n_nodes + node];
+        }
+        m_specularResult.amplitudes.emplace_back(value * m_inputData.intensity);
+    }
     m_specularResult.qvalues = m_inputData.qvalues;
+
+    if (!m_inputData.zvalues.empty()) {
+        m_specularResult.zvalues = m_inputData.zvalues;
+        m_specularResult.field_intensity = FieldIntensity::Calculate(
+            m_inputData.slice_data, m_inputData.qvalues, m_inputData.zvalues);
+    }
 }
 
 void SpecularToySimulation::setProgressCallback(ModelView::ProgressHandler::callback_t callback)
@@ -68,7 +119,10 @@ SpecularToySimulation::sld_profile(const multislice_t& multislice, int n_points)
     return {xmin, xmax, ModelView::Utils::Real(profile)};
 }
 
+//! Returns the number of q-values to compute, including the points of resolution smearing.
+
 size_t SpecularToySimulation::scanPointsCount() const
 {
-    return m_inputData.qvalues.size();
+    const size_t n_nodes = m_inputData.qresolution.empty() ? 1 : smearing_quadrature.size();
+    return m_inputData.qvalues.size() * n_nodes;
 }
@@ -32,6 +32,8 @@ public:
     struct Result {
         std::vector<double> qvalues;
         std::vector<double> amplitudes;
+        std::vector<double> zvalues;
+        std::vector<double> field_intensity; //! |psi(z,q)|^2, z is the fastest running index
     };
 
     //! Represents data to run specular simulations.
@@ -39,6 +41,8 @@ public:
         std::vector<double> qvalues;
         multislice_t slice_data;
         double intensity;
+        std::vector<double> zvalues; //! depth grid for field intensity map, empty if not needed
+        std::vector<double> qresolution; //! standard deviation of q-values, empty if not smeared
     };
 
     SpecularToySimulation(const InputData& input_data);
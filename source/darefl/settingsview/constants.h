@@ -13,9 +13,17 @@
 //! @file constants.h
 //! Collection of contants for the whole GUI.
 
+#include <cstddef>
+
 namespace Constants
 {
 const inline bool live_simulation_default_on = false;
-}
+
+//! Memory budget (in bytes) for the cache of specular simulation results.
+const inline size_t simulation_cache_memory_budget = 64 * 1024 * 1024;
+
+//! Minimal interval (in msec) between autosaves of changed models.
+const inline int autosave_interval_msec = 10000;
+} // namespace Constants
 
 #endif // DAREFL_SETTINGSVIEW_CONSTANTS_H
@@ -7,8 +7,10 @@
 //
 // ************************************************************************** //
 
+#include <QMouseEvent>
 #include <QResizeEvent>
 #include <darefl/model/applicationmodels.h>
+#include <darefl/model/edithistory.h>
 #include <darefl/model/jobmodel.h>
 #include <darefl/sldeditor/graphicsscene.h>
 #include <darefl/sldeditor/sldelementcontroller.h>
@@ -35,6 +37,7 @@ void SLDViewWidget::setModels(ApplicationModels* models)
         models->materialModel(), models->sampleModel(), models->sldViewModel(), nullptr);
     m_sld_controller->setScene(dynamic_cast<GraphicsScene*>(scene()));
     dynamic_cast<GraphicsScene*>(scene())->setItem(models->jobModel()->sld_viewport());
+    m_edit_history = models->editHistory();
 }
 
 //! Resize event management
@@ -44,3 +47,19 @@ void SLDViewWidget::resizeEvent(QResizeEvent* event)
     GraphicsScene* scene_item = static_cast<GraphicsScene*>(scene());
     scene_item->update_size(event->size());
 }
+
+//! All changes made while dragging an element are undone in one step
+void SLDViewWidget::mousePressEvent(QMouseEvent* event)
+{
+    if (m_edit_history)
+        m_edit_history->beginMacro();
+    QGraphicsView::mousePressEvent(event);
+}
+
+//! Ends the macro of the drag
+void SLDViewWidget::mouseReleaseEvent(QMouseEvent* event)
+{
+    QGraphicsView::mouseReleaseEvent(event);
+    if (m_edit_history)
+        m_edit_history->endMacro();
+}
@@ -11,6 +11,7 @@
 #include <memory>
 
 class ApplicationModels;
+class EditHistory;
 class SLDElementController;
 
 //! The segment QGraphicsViewItem on the Graphicsscene
@@ -26,7 +27,10 @@ public:
 
 protected:
     void resizeEvent(QResizeEvent* event);
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
 
 private:
     std::unique_ptr<SLDElementController> m_sld_controller;
+    EditHistory* m_edit_history{nullptr};
 };
@@ -0,0 +1,224 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLockFile>
+#include <QStandardPaths>
+#include <QTimer>
+#include <darefl/model/applicationmodels.h>
+#include <darefl/model/experimentaldatamodel.h>
+#include <darefl/settingsview/constants.h>
+#include <darefl/welcomeview/autosavecontroller.h>
+#include <mvvm/factories/modelconverterfactory.h>
+#include <mvvm/model/sessionmodel.h>
+#include <mvvm/project/modelhaschangedcontroller.h>
+#include <mvvm/serialization/jsonmodelconverterinterface.h>
+#include <stdexcept>
+
+using namespace ModelView;
+
+namespace
+{
+const int max_journal_count = 100;
+
+//! Journal record with the project directory, model types can't clash with it.
+const std::string project_dir_key = "#ProjectDir";
+
+//! Returns the name of the journal with given index in the directory.
+std::string journal_file_name(const std::string& journal_dir, int index)
+{
+    auto name = index == 0 ? QString("autosave.journal")
+                           : QString("autosave.%1.journal").arg(index);
+    return QDir(QString::fromStdString(journal_dir)).filePath(name).toStdString();
+}
+
+} // namespace
+
+AutosaveController::AutosaveController(ApplicationModels* models, const std::string& journal_dir,
+                                       callback_t project_dir_callback, QObject* parent)
+    : QObject(parent), m_models(models), m_project_dir_callback(std::move(project_dir_callback)),
+      m_timer(new QTimer(this))
+{
+    lockJournal(journal_dir);
+    m_journal = std::make_unique<AutosaveJournal>(m_journal_file_name);
+
+    m_timer->setSingleShot(true);
+    m_timer->setInterval(Constants::autosave_interval_msec);
+    connect(m_timer, &QTimer::timeout, this, &AutosaveController::onAutosave);
+
+    for (auto model : m_models->persistent_models())
+        m_changed_controllers.push_back(std::make_unique<ModelHasChangedController>(
+            model, [this, model]() { onModelChanged(model); }));
+}
+
+AutosaveController::~AutosaveController() = default;
+
+//! Returns the application data directory, where journals are kept.
+
+std::string AutosaveController::defaultJournalDir()
+{
+    QDir dir(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation));
+    dir.mkpath(".");
+    return dir.absolutePath().toStdString();
+}
+
+//! Returns the name of the journal locked by this instance.
+
+std::string AutosaveController::journalFileName() const
+{
+    return m_journal_file_name;
+}
+
+//! Sets the minimal time between two autosaves.
+
+void AutosaveController::setInterval(int msec)
+{
+    m_timer->setInterval(msec);
+}
+
+//! Returns true if the last session left unsaved changes in the journal.
+
+bool AutosaveController::hasRecoveryData() const
+{
+    return !m_recovery_records.empty();
+}
+
+//! Returns the directory of the project the last session worked on, empty if it wasn't saved.
+//! The project should be reopened before its changes are recovered.
+
+std::string AutosaveController::recoveryProjectDir() const
+{
+    auto it = m_recovery_records.find(project_dir_key);
+    return it == m_recovery_records.end() ? std::string() : it->second;
+}
+
+//! Restores models from the journal left by the last session, together with full-resolution data
+//! which wasn't saved in the project. Restored models are autosaved again, until the project is
+//! saved.
+
+void AutosaveController::recover()
+{
+    auto records = std::move(m_recovery_records);
+    m_recovery_records.clear();
+    auto entries = std::move(m_recovery_entries);
+    m_recovery_entries.clear();
+    clear();
+
+    auto converter = CreateModelProjectConverter();
+    for (auto model : m_models->persistent_models()) {
+        auto it = records.find(model->modelType());
+        if (it == records.end())
+            continue;
+        auto document = QJsonDocument::fromJson(QByteArray::fromStdString(it->second));
+        if (document.isObject())
+            converter->from_json(document.object(), *model);
+    }
+    if (!entries.empty())
+        m_models->experimentalDataModel()->addDataStoreEntries(entries);
+}
+
+//! Discards autosaved changes, e.g. when the project was saved or closed. Changes left by the
+//! last session stay available for recover().
+
+void AutosaveController::clear()
+{
+    m_dirty_models.clear();
+    m_journaled_entries.clear();
+    m_timer->stop();
+    m_journal->clear();
+}
+
+//! Sets full-resolution data which is kept in the project directory, e.g. when the project was
+//! saved or its data was loaded. Only data which isn't there is journaled.
+
+void AutosaveController::setProjectDataStore(const ExperimentalDataStore::entries_t& entries)
+{
+    m_project_entries.clear();
+    for (const auto& [key, columns] : entries)
+        m_project_entries[key] = columns;
+}
+
+//! Appends changed models to the journal. Full-resolution data they refer to is written first.
+
+void AutosaveController::onAutosave()
+{
+    if (m_dirty_models.count(m_models->experimentalDataModel()))
+        journalDataStore();
+
+    AutosaveJournal::records_t records;
+    auto converter = CreateModelProjectConverter();
+    for (auto model : m_dirty_models) {
+        auto document = QJsonDocument(converter->to_json(*model));
+        records[model->modelType()] = document.toJson(QJsonDocument::Compact).toStdString();
+    }
+    m_dirty_models.clear();
+    if (m_project_dir_callback)
+        records[project_dir_key] = m_project_dir_callback();
+    m_journal->append(records);
+}
+
+//! Locks the first journal in the directory which isn't used by another running instance.
+//! Journals left with records by a crashed instance are preferred, to offer their recovery.
+
+void AutosaveController::lockJournal(const std::string& journal_dir)
+{
+    for (int index = 0; index < max_journal_count; ++index) {
+        auto file_name = journal_file_name(journal_dir, index);
+        auto lock = std::make_unique<QLockFile>(QString::fromStdString(file_name + ".lock"));
+        if (!lock->tryLock())
+            continue;
+
+        auto records = AutosaveJournal::read(file_name);
+        if (m_journal_lock && records.empty())
+            continue;
+        m_journal_file_name = file_name;
+        m_journal_lock = std::move(lock);
+        m_recovery_records = std::move(records);
+        m_recovery_entries = AutosaveJournal::readDataStore(file_name);
+        if (!m_recovery_records.empty())
+            return;
+    }
+
+    if (!m_journal_lock)
+        throw std::runtime_error("Error in AutosaveController: can't lock a journal in '"
+                                 + journal_dir + "'.");
+}
+
+//! Marks the model as dirty, schedules the autosave unless it's already scheduled. Decimated views
+//! of experimental data follow zoom and pan, they are derived from the stored data and skipped.
+
+void AutosaveController::onModelChanged(SessionModel* model)
+{
+    if (m_models->experimentalDataModel()->isViewUpdateInProgress())
+        return;
+
+    m_dirty_models.insert(model);
+    if (!m_timer->isActive())
+        m_timer->start();
+}
+
+//! Requests the journal to write full-resolution data which isn't in the project directory, if it
+//! changed since the last autosave. The journal thread writes columns shared with the model.
+
+void AutosaveController::journalDataStore()
+{
+    ExperimentalDataStore::entries_t entries;
+    for (const auto& entry : m_models->experimentalDataModel()->dataStoreEntries()) {
+        auto it = m_project_entries.find(entry.first);
+        if (it == m_project_entries.end() || it->second != entry.second)
+            entries.push_back(entry);
+    }
+    if (entries == m_journaled_entries)
+        return;
+
+    m_journal->writeDataStore(entries);
+    m_journaled_entries = std::move(entries);
+}
@@ -0,0 +1,83 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#ifndef DAREFL_WELCOMEVIEW_AUTOSAVECONTROLLER_H
+#define DAREFL_WELCOMEVIEW_AUTOSAVECONTROLLER_H
+
+#include <QObject>
+#include <darefl/welcomeview/autosavejournal.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+class QLockFile;
+class QTimer;
+class ApplicationModels;
+
+namespace ModelView
+{
+class ModelHasChangedController;
+class SessionModel;
+} // namespace ModelView
+
+//! Autosaves changed persistent models into the journal, to recover them after a crash.
+//! Models are serialized in the GUI thread at most once per autosave interval, and only those
+//! changed since the last autosave. The journal is written in the background, together with
+//! the directory of the current project. Updates of decimated views of experimental data don't
+//! make the model dirty. Full-resolution experimental data which isn't in the project directory
+//! is written by the journal next to it, shared with the model without copies. Every running
+//! instance locks its own journal in the journal directory.
+
+class AutosaveController : public QObject
+{
+    Q_OBJECT
+public:
+    using callback_t = std::function<std::string()>;
+
+    AutosaveController(ApplicationModels* models, const std::string& journal_dir,
+                       callback_t project_dir_callback = {}, QObject* parent = nullptr);
+    ~AutosaveController() override;
+
+    static std::string defaultJournalDir();
+
+    std::string journalFileName() const;
+    void setInterval(int msec);
+
+    bool hasRecoveryData() const;
+    std::string recoveryProjectDir() const;
+    void recover();
+    void clear();
+    void setProjectDataStore(const ExperimentalDataStore::entries_t& entries);
+
+private slots:
+    void onAutosave();
+
+private:
+    void lockJournal(const std::string& journal_dir);
+    void onModelChanged(ModelView::SessionModel* model);
+    void journalDataStore();
+
+    ApplicationModels* m_models{nullptr};
+    callback_t m_project_dir_callback;
+    std::string m_journal_file_name;
+    std::unique_ptr<QLockFile> m_journal_lock;
+    AutosaveJournal::records_t m_recovery_records; //! journal content left by the last session
+    ExperimentalDataStore::entries_t m_recovery_entries; //! data left by the last session
+    std::map<std::string, ExperimentalDataStore::columns_t> m_project_entries; //! saved data
+    ExperimentalDataStore::entries_t m_journaled_entries;
+    std::unique_ptr<AutosaveJournal> m_journal;
+    std::vector<std::unique_ptr<ModelView::ModelHasChangedController>> m_changed_controllers;
+    std::set<ModelView::SessionModel*> m_dirty_models;
+    QTimer* m_timer{nullptr};
+};
+
+#endif // DAREFL_WELCOMEVIEW_AUTOSAVECONTROLLER_H
@@ -0,0 +1,154 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include <QFile>
+#include <QSaveFile>
+#include <darefl/welcomeview/autosavejournal.h>
+
+namespace
+{
+const char separator = '\t';
+
+//! Returns the record as a line of the journal. Model type and content shouldn't contain
+//! newlines, which holds for compact JSON.
+std::string to_line(const std::string& model_type, const std::string& content)
+{
+    return model_type + separator + content + '\n';
+}
+
+bool write_line(QIODevice& device, const std::string& line)
+{
+    return device.write(line.data(), static_cast<qint64>(line.size()))
+           == static_cast<qint64>(line.size());
+}
+
+} // namespace
+
+AutosaveJournal::AutosaveJournal(const std::string& file_name, size_t max_records)
+    : m_file_name(file_name), m_max_records(max_records)
+{
+}
+
+//! Finishes pending requests.
+
+AutosaveJournal::~AutosaveJournal() = default;
+
+//! Requests appending of records to the journal.
+
+void AutosaveJournal::append(const records_t& records)
+{
+    m_queue.push([this, records]() { write_records(records); });
+}
+
+//! Requests writing of full-resolution data, which replaces the data written before. Entries
+//! share immutable columns with the store, so they are written in the background while the model
+//! is being edited. Records appended later are written after the data they refer to.
+
+void AutosaveJournal::writeDataStore(const ExperimentalDataStore::entries_t& entries)
+{
+    m_queue.push([this, entries]() {
+        const auto file_name = dataStoreFileName(m_file_name);
+        if (entries.empty())
+            QFile::remove(QString::fromStdString(file_name));
+        else
+            ExperimentalDataStore::write(file_name, entries);
+    });
+}
+
+//! Requests removal of the journal and its data, e.g. when all changes are saved.
+
+void AutosaveJournal::clear()
+{
+    m_queue.push([this]() {
+        m_latest.clear();
+        m_record_count = 0;
+        QFile::remove(QString::fromStdString(m_file_name));
+        QFile::remove(QString::fromStdString(dataStoreFileName(m_file_name)));
+    });
+}
+
+//! Blocks until all requests are served.
+
+void AutosaveJournal::wait()
+{
+    m_queue.wait();
+}
+
+//! Returns the latest record of every model found in the journal. Incomplete lines are skipped.
+
+AutosaveJournal::records_t AutosaveJournal::read(const std::string& file_name)
+{
+    records_t result;
+    QFile file(QString::fromStdString(file_name));
+    if (!file.open(QIODevice::ReadOnly))
+        return result;
+
+    const auto content = file.readAll().toStdString();
+    size_t begin = 0;
+    for (auto end = content.find('\n'); end != std::string::npos;
+         begin = end + 1, end = content.find('\n', begin)) {
+        auto pos = content.find(separator, begin);
+        if (pos != std::string::npos && pos < end)
+            result[content.substr(begin, pos - begin)] = content.substr(pos + 1, end - pos - 1);
+    }
+    return result;
+}
+
+//! Returns full-resolution data kept next to the journal. Unreadable data is skipped.
+
+ExperimentalDataStore::entries_t AutosaveJournal::readDataStore(const std::string& file_name)
+{
+    ExperimentalDataStore::entries_t result;
+    ExperimentalDataStore::read(dataStoreFileName(file_name), result);
+    return result;
+}
+
+//! Returns the name of the file with full-resolution data of the journal.
+
+std::string AutosaveJournal::dataStoreFileName(const std::string& file_name)
+{
+    return file_name + ".data";
+}
+
+//! Appends records to the end of the journal, compacts it if it became too long.
+
+void AutosaveJournal::write_records(const records_t& records)
+{
+    for (const auto& [model_type, content] : records)
+        m_latest[model_type] = content;
+    m_record_count += records.size();
+
+    if (m_record_count > m_max_records) {
+        compact();
+        return;
+    }
+
+    // after a failed write, the journal might end with an incomplete line, it's rewritten then
+    QFile file(QString::fromStdString(m_file_name));
+    bool success = file.open(QIODevice::WriteOnly | QIODevice::Append);
+    for (auto it = records.begin(); success && it != records.end(); ++it)
+        success = write_line(file, to_line(it->first, it->second));
+    if (!success)
+        m_record_count = m_max_records;
+}
+
+//! Rewrites the journal with the latest record of every model. The old journal stays intact
+//! until the new one is complete.
+
+void AutosaveJournal::compact()
+{
+    QSaveFile file(QString::fromStdString(m_file_name));
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    for (const auto& [model_type, content] : m_latest)
+        if (!write_line(file, to_line(model_type, content)))
+            return;
+    if (file.commit())
+        m_record_count = m_latest.size();
+}
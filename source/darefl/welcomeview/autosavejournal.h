@@ -0,0 +1,54 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#ifndef DAREFL_WELCOMEVIEW_AUTOSAVEJOURNAL_H
+#define DAREFL_WELCOMEVIEW_AUTOSAVEJOURNAL_H
+
+#include <darefl/model/experimentaldatastore.h>
+#include <darefl/welcomeview/serialtaskqueue.h>
+#include <map>
+#include <string>
+
+//! Journal of serialized models, appended in a background thread to recover unsaved changes
+//! after a crash. Every record is a line with the model type and its compact serialized content,
+//! the latest record of the model wins. A line cut by a crash lacks the final newline and is
+//! ignored. When the number of records exceeds the limit, the journal is rewritten with the
+//! latest records only. Full-resolution experimental data, which isn't part of serialized models,
+//! is kept in the data file next to the journal.
+
+class AutosaveJournal
+{
+public:
+    using records_t = std::map<std::string, std::string>; //! serialized models by model type
+
+    AutosaveJournal(const std::string& file_name, size_t max_records = 50);
+    ~AutosaveJournal();
+
+    void append(const records_t& records);
+    void writeDataStore(const ExperimentalDataStore::entries_t& entries);
+    void clear();
+    void wait();
+
+    static records_t read(const std::string& file_name);
+    static ExperimentalDataStore::entries_t readDataStore(const std::string& file_name);
+    static std::string dataStoreFileName(const std::string& file_name);
+
+private:
+    void write_records(const records_t& records);
+    void compact();
+
+    std::string m_file_name;
+    size_t m_max_records{0};
+    records_t m_latest;       //! latest records in the journal, used by the worker thread only
+    size_t m_record_count{0}; //! number of records in the journal, used by the worker thread only
+
+    SerialTaskQueue m_queue; //! declared last, so pending requests are served first
+};
+
+#endif // DAREFL_WELCOMEVIEW_AUTOSAVEJOURNAL_H
@@ -0,0 +1,119 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include <algorithm>
+#include <darefl/welcomeview/datastoreworker.h>
+
+DataStoreWorker::DataStoreWorker(QObject* parent) : QObject(parent) {}
+
+//! Finishes pending requests, so the project on disk is complete.
+
+DataStoreWorker::~DataStoreWorker() = default;
+
+//! Requests writing of entries into the file. If the project is still being loaded, the loaded
+//! entries are written too, unless given entries have the same key.
+
+void DataStoreWorker::save(const std::string& file_name,
+                           const ExperimentalDataStore::entries_t& entries)
+{
+    size_t merge_load{0};
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        merge_load = m_pending_load;
+    }
+
+    m_queue.push([this, file_name, entries, merge_load]() {
+        auto all_entries = entries;
+        if (merge_load != 0 && merge_load == m_merge_load) {
+            for (const auto& entry : m_merge_entries) {
+                auto has_key = [&entry](const auto& other) { return other.first == entry.first; };
+                if (std::none_of(entries.begin(), entries.end(), has_key))
+                    all_entries.push_back(entry);
+            }
+        }
+        auto on_progress = [this](int value) { progressChanged(value); };
+        saveCompleted(ExperimentalDataStore::write(file_name, all_entries, on_progress));
+    });
+}
+
+//! Requests reading of entries from the file. Result of the previous load request, if any, is
+//! discarded.
+
+void DataStoreWorker::load(const std::string& file_name)
+{
+    size_t load_id{0};
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        load_id = ++m_load_count;
+        m_pending_load = load_id;
+        m_loaded_entries.reset();
+    }
+
+    m_queue.push([this, file_name, load_id]() {
+        auto on_progress = [this](int value) { progressChanged(value); };
+        ExperimentalDataStore::entries_t entries;
+        bool success = ExperimentalDataStore::read(file_name, entries, on_progress);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (load_id != m_load_count)
+                return;
+            m_loaded_entries = entries;
+        }
+        m_merge_load = load_id;
+        m_merge_entries = std::move(entries);
+        loadCompleted(success);
+    });
+}
+
+//! Results of all load requests made so far won't be reported.
+
+void DataStoreWorker::discardLoad()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_load_count;
+        m_pending_load = 0;
+        m_loaded_entries.reset();
+    }
+    releaseMergeEntries();
+}
+
+//! Blocks until all requests are served.
+
+void DataStoreWorker::wait()
+{
+    m_queue.wait();
+}
+
+//! Returns the result of the last load request, if it is ready and wasn't taken yet.
+
+std::optional<ExperimentalDataStore::entries_t> DataStoreWorker::takeLoadedEntries()
+{
+    std::optional<ExperimentalDataStore::entries_t> result;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        result = std::move(m_loaded_entries);
+        m_loaded_entries.reset();
+        if (result)
+            m_pending_load = 0;
+    }
+    if (result)
+        releaseMergeEntries();
+    return result;
+}
+
+//! Drops the loaded entries kept for saving, once all save requests made before are served.
+
+void DataStoreWorker::releaseMergeEntries()
+{
+    m_queue.push([this]() {
+        m_merge_load = 0;
+        m_merge_entries.clear();
+    });
+}
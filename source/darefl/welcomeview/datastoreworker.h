@@ -0,0 +1,59 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#ifndef DAREFL_WELCOMEVIEW_DATASTOREWORKER_H
+#define DAREFL_WELCOMEVIEW_DATASTOREWORKER_H
+
+#include <QObject>
+#include <darefl/model/experimentaldatastore.h>
+#include <darefl/welcomeview/serialtaskqueue.h>
+#include <mutex>
+#include <optional>
+
+//! Writes and reads full-resolution experimental data of the project in a background thread.
+//! Requests are served one after another in the order they were made, so the data which is read
+//! is always the one written last. Entries to write are an immutable snapshot, the model can be
+//! edited meanwhile. Data of a load which wasn't taken yet is written together with them.
+//! Signals are emitted from the worker thread.
+
+class DataStoreWorker : public QObject
+{
+    Q_OBJECT
+public:
+    DataStoreWorker(QObject* parent = nullptr);
+    ~DataStoreWorker() override;
+
+    void save(const std::string& file_name, const ExperimentalDataStore::entries_t& entries);
+    void load(const std::string& file_name);
+    void discardLoad();
+    void wait();
+
+    std::optional<ExperimentalDataStore::entries_t> takeLoadedEntries();
+
+signals:
+    void progressChanged(int value);
+    void saveCompleted(bool success);
+    void loadCompleted(bool success);
+
+private:
+    void releaseMergeEntries();
+
+    std::mutex m_mutex;
+    size_t m_load_count{0}; //! Number of load requests made so far, older results are dropped.
+    size_t m_pending_load{0}; //! Load request whose result wasn't taken yet, 0 if none.
+    std::optional<ExperimentalDataStore::entries_t> m_loaded_entries;
+
+    // result of the last load for the save requests made before it was taken, worker thread only
+    size_t m_merge_load{0};
+    ExperimentalDataStore::entries_t m_merge_entries;
+
+    SerialTaskQueue m_queue; //! declared last, so pending requests are served first
+};
+
+#endif // DAREFL_WELCOMEVIEW_DATASTOREWORKER_H
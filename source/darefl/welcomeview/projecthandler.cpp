@@ -8,7 +8,14 @@
 // ************************************************************************** //
 
 #include <QMainWindow>
+#include <QStatusBar>
+#include <QTimer>
+#include <algorithm>
 #include <darefl/model/applicationmodels.h>
+#include <darefl/model/experimentaldatamodel.h>
+#include <darefl/model/experimentaldatastore.h>
+#include <darefl/welcomeview/autosavecontroller.h>
+#include <darefl/welcomeview/datastoreworker.h>
 #include <darefl/welcomeview/projecthandler.h>
 #include <darefl/welcomeview/recentprojectsettings.h>
 #include <darefl/welcomeview/recentprojectwidget.h>
@@ -22,10 +29,23 @@ using namespace ModelView;
 ProjectHandler::ProjectHandler(ApplicationModels* models, QWidget* parent)
     : QObject(parent), m_recentProjectSettings(std::make_unique<RecentProjectSettings>()),
       m_userInteractor(std::make_unique<UserInteractor>(m_recentProjectSettings.get(), parent)),
-      m_models(models)
+      m_dataStoreWorker(std::make_unique<DataStoreWorker>()), m_models(models)
 {
+    connect(m_dataStoreWorker.get(), &DataStoreWorker::progressChanged, this,
+            &ProjectHandler::onDataStoreProgress, Qt::QueuedConnection);
+    connect(m_dataStoreWorker.get(), &DataStoreWorker::saveCompleted, this,
+            &ProjectHandler::onDataStoreSaved, Qt::QueuedConnection);
+    connect(m_dataStoreWorker.get(), &DataStoreWorker::loadCompleted, this,
+            &ProjectHandler::onDataStoreLoaded, Qt::QueuedConnection);
+
     initProjectManager();
     updateRecentProjectNames();
+
+    m_autosaveController = std::make_unique<AutosaveController>(
+        m_models, AutosaveController::defaultJournalDir(),
+        [this]() { return m_projectManager->currentProjectDir(); });
+    // offering recovery when the main window is already shown
+    QTimer::singleShot(0, this, &ProjectHandler::onRecoveryRequest);
 }
 
 ProjectHandler::~ProjectHandler() = default;
@@ -41,33 +61,93 @@ void ProjectHandler::updateNames()
 //! Returns 'true' if current project can be closed.
 //! Internally will perform check for unsaved data, and proceed via save/discard/cancel dialog.
 
-bool ProjectHandler::canCloseProject() const
+bool ProjectHandler::canCloseProject()
 {
-    return m_projectManager->closeCurrentProject();
+    if (!processRequest([this]() { return m_projectManager->closeCurrentProject(); }))
+        return false;
+    m_autosaveController->clear();
+    return true;
 }
 
 void ProjectHandler::onCreateNewProject()
 {
-    if (m_projectManager->createNewProject())
+    if (processRequest([this]() { return m_projectManager->createNewProject(); })) {
+        m_dataStoreWorker->discardLoad();
+        m_models->experimentalDataModel()->setDataStoreEntries({});
+        m_autosaveController->clear();
+        m_autosaveController->setProjectDataStore({});
         updateNames();
+    }
 }
 
 void ProjectHandler::onOpenExistingProject(const QString& dirname)
 {
-    if (m_projectManager->openExistingProject(dirname.toStdString()))
+    auto open_request = [this, &dirname]() {
+        return m_projectManager->openExistingProject(dirname.toStdString());
+    };
+    if (processRequest(open_request)) {
+        // decimated views of experimental data are part of the model and are shown right away,
+        // they aren't taken as the source of the data until the stored data arrives
+        m_models->experimentalDataModel()->beginDataStoreLoad();
+        m_dataStoreWorker->load(
+            ExperimentalDataModel::dataStoreFileName(m_projectManager->currentProjectDir()));
+        m_autosaveController->clear();
+        m_autosaveController->setProjectDataStore({});
         updateNames();
+    }
 }
 
 void ProjectHandler::onSaveCurrentProject()
 {
-    if (m_projectManager->saveCurrentProject())
+    auto entries = dataStoreEntries();
+    if (m_projectManager->saveCurrentProject()) {
+        saveDataStore(m_projectManager->currentProjectDir(), entries);
+        m_autosaveController->clear();
+        m_autosaveController->setProjectDataStore(entries);
         updateNames();
+    }
 }
 
 void ProjectHandler::onSaveProjectAs()
 {
-    if (m_projectManager->saveProjectAs())
+    auto entries = dataStoreEntries();
+    if (m_projectManager->saveProjectAs()) {
+        saveDataStore(m_projectManager->currentProjectDir(), entries);
+        m_autosaveController->clear();
+        m_autosaveController->setProjectDataStore(entries);
         updateNames();
+    }
+}
+
+void ProjectHandler::onDataStoreProgress(int value)
+{
+    showStatusMessage(QString("Processing experimental data: %1%").arg(value));
+}
+
+void ProjectHandler::onDataStoreSaved(bool success)
+{
+    showStatusMessage(success ? "Experimental data saved" : "Failed to save experimental data");
+}
+
+void ProjectHandler::onDataStoreLoaded(bool success)
+{
+    applyLoadedDataStore();
+    showStatusMessage(success ? "Experimental data loaded" : "Failed to load experimental data");
+}
+
+//! Offers to recover unsaved changes left by the previous session. The project they were made
+//! in is reopened first. Declined changes are discarded.
+
+void ProjectHandler::onRecoveryRequest()
+{
+    if (m_autosaveController->hasRecoveryData() && m_userInteractor->onRecoveryRequest()) {
+        auto project_dir = m_autosaveController->recoveryProjectDir();
+        if (!project_dir.empty())
+            onOpenExistingProject(QString::fromStdString(project_dir));
+        m_autosaveController->recover();
+    } else {
+        m_autosaveController->clear();
+    }
 }
 
 void ProjectHandler::clearRecentProjectsList()
@@ -83,8 +163,17 @@ void ProjectHandler::initProjectManager()
     ProjectContext project_context{modified_callback, models_callback};
 
     auto select_dir_callback = [this]() { return m_userInteractor->onSelectDirRequest(); };
-    auto create_dir_callback = [this]() { return m_userInteractor->onCreateDirRequest(); };
-    auto answer_callback = [this]() { return m_userInteractor->onSaveChangesRequest(); };
+    // directories where the models get saved are remembered, see processRequest()
+    auto create_dir_callback = [this]() {
+        m_savedProjectDir = m_userInteractor->onCreateDirRequest();
+        return m_savedProjectDir;
+    };
+    auto answer_callback = [this]() {
+        auto answer = m_userInteractor->onSaveChangesRequest();
+        if (answer == SaveChangesAnswer::SAVE)
+            m_savedProjectDir = m_projectManager->currentProjectDir();
+        return answer;
+    };
     UserInteractionContext user_context{select_dir_callback, create_dir_callback, answer_callback};
 
     m_projectManager = CreateProjectManager(project_context, user_context);
@@ -113,3 +202,60 @@ void ProjectHandler::updateRecentProjectNames()
         QString::fromStdString(m_projectManager->currentProjectDir()));
     recentProjectsListModified(m_recentProjectSettings->recentProjects());
 }
+
+//! Performs the request of the project manager, which closes the current project. If the user
+//! chooses to save the project before, the experimental data is saved next to the models.
+
+bool ProjectHandler::processRequest(const std::function<bool()>& request)
+{
+    auto entries = dataStoreEntries();
+    m_savedProjectDir.clear();
+    const bool success = request();
+    if (!m_savedProjectDir.empty())
+        saveDataStore(m_savedProjectDir, entries);
+    return success;
+}
+
+//! Returns full-resolution experimental data of the current project. Data which is still being
+//! loaded isn't awaited, DataStoreWorker adds it when saving.
+
+ExperimentalDataStore::entries_t ProjectHandler::dataStoreEntries()
+{
+    applyLoadedDataStore();
+    return m_models->experimentalDataModel()->dataStoreEntries();
+}
+
+//! Saves full-resolution experimental data into the project directory in the background.
+
+void ProjectHandler::saveDataStore(const std::string& dirname,
+                                   const ExperimentalDataStore::entries_t& entries)
+{
+    m_dataStoreWorker->save(ExperimentalDataModel::dataStoreFileName(dirname), entries);
+}
+
+//! Puts loaded experimental data into the model. Data imported or recovered while loading is
+//! newer and is kept. Listeners of the model are notified about the new source of the data items.
+//! Loaded data is in the project directory and isn't autosaved.
+
+void ProjectHandler::applyLoadedDataStore()
+{
+    auto loaded = m_dataStoreWorker->takeLoadedEntries();
+    if (!loaded)
+        return;
+
+    auto model = m_models->experimentalDataModel();
+    auto entries = model->dataStoreEntries();
+    for (const auto& entry : *loaded) {
+        auto has_key = [&entry](const auto& other) { return other.first == entry.first; };
+        if (std::none_of(entries.begin(), entries.end(), has_key))
+            entries.push_back(entry);
+    }
+    model->setDataStoreEntries(entries);
+    m_autosaveController->setProjectDataStore(*loaded);
+}
+
+void ProjectHandler::showStatusMessage(const QString& message)
+{
+    if (auto main_window = ModelView::Utils::FindMainWindow(); main_window)
+        main_window->statusBar()->showMessage(message, 5000);
+}
@@ -11,7 +11,10 @@
 #define DAREFL_WELCOMEVIEW_PROJECTHANDLER_H
 
 #include <QObject>
+#include <darefl/model/experimentaldatastore.h>
+#include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 class QWidget;
@@ -21,6 +24,8 @@ namespace ModelView
 class ProjectManagerInterface;
 }
 
+class AutosaveController;
+class DataStoreWorker;
 class RecentProjectSettings;
 class UserInteractor;
 class ApplicationModels;
@@ -28,6 +33,10 @@ class RecentProjectWidget;
 
 //! Main class to coordinate all activity on user's request to create new project,
 //! open existing one, or choose one of recent projects on disk.
+//! Models are saved and loaded by the project manager. Full-resolution experimental data is
+//! written and read in the background: the sample is shown as soon as the project is open, while
+//! experimental data arrives later. Unsaved changes are autosaved, to be recovered on the next
+//! start after a crash.
 
 class ProjectHandler : public QObject
 {
@@ -42,7 +51,7 @@ signals:
 
 public slots:
     void updateNames();
-    bool canCloseProject() const;
+    bool canCloseProject();
     void onCreateNewProject();
     void onOpenExistingProject(const QString& dirname = {});
     void onSaveCurrentProject();
@@ -50,15 +59,30 @@ public slots:
 
     void clearRecentProjectsList();
 
+private slots:
+    void onDataStoreProgress(int value);
+    void onDataStoreSaved(bool success);
+    void onDataStoreLoaded(bool success);
+    void onRecoveryRequest();
+
 private:
     void initProjectManager();
     void updateCurrentProjectName();
     void updateRecentProjectNames();
+    bool processRequest(const std::function<bool()>& request);
+    ExperimentalDataStore::entries_t dataStoreEntries();
+    void saveDataStore(const std::string& dirname,
+                       const ExperimentalDataStore::entries_t& entries);
+    void applyLoadedDataStore();
+    void showStatusMessage(const QString& message);
 
     std::unique_ptr<RecentProjectSettings> m_recentProjectSettings;
     std::unique_ptr<UserInteractor> m_userInteractor;
     std::unique_ptr<ModelView::ProjectManagerInterface> m_projectManager;
+    std::unique_ptr<DataStoreWorker> m_dataStoreWorker;
+    std::unique_ptr<AutosaveController> m_autosaveController;
     ApplicationModels* m_models{nullptr};
+    std::string m_savedProjectDir; //! directory the models were saved to during the last request
 };
 
 #endif // DAREFL_WELCOMEVIEW_PROJECTHANDLER_H
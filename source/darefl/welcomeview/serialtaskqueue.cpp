@@ -0,0 +1,67 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include <darefl/welcomeview/serialtaskqueue.h>
+
+SerialTaskQueue::SerialTaskQueue()
+{
+    m_thread = std::thread{&SerialTaskQueue::run, this};
+}
+
+//! Finishes pending tasks and stops the thread.
+
+SerialTaskQueue::~SerialTaskQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_is_running = false;
+    }
+    m_condition.notify_all();
+    m_thread.join();
+}
+
+//! Adds the task to the end of the queue.
+
+void SerialTaskQueue::push(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_condition.notify_all();
+}
+
+//! Blocks until all tasks are finished.
+
+void SerialTaskQueue::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this]() { return m_tasks.empty() && !m_is_busy; });
+}
+
+//! Runs tasks one after another. Method is intended for execution in a thread.
+
+void SerialTaskQueue::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_condition.wait(lock, [this]() { return !m_tasks.empty() || !m_is_running; });
+        if (m_tasks.empty())
+            return;
+
+        auto task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+        m_is_busy = true;
+        lock.unlock();
+        task();
+        lock.lock();
+        m_is_busy = false;
+        m_condition.notify_all();
+    }
+}
@@ -0,0 +1,43 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#ifndef DAREFL_WELCOMEVIEW_SERIALTASKQUEUE_H
+#define DAREFL_WELCOMEVIEW_SERIALTASKQUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+//! Runs tasks in a background thread one after another, in the order they were pushed.
+//! Pending tasks are finished before the queue is destroyed, so the owner should declare the
+//! queue after all members its tasks use.
+
+class SerialTaskQueue
+{
+public:
+    SerialTaskQueue();
+    ~SerialTaskQueue();
+
+    void push(std::function<void()> task);
+    void wait();
+
+private:
+    void run();
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::function<void()>> m_tasks;
+    bool m_is_busy{false};
+    bool m_is_running{true};
+    std::thread m_thread;
+};
+
+#endif // DAREFL_WELCOMEVIEW_SERIALTASKQUEUE_H
@@ -92,6 +92,18 @@ SaveChangesAnswer UserInteractor::onSaveChangesRequest()
     return translate[ret];
 }
 
+//! Returns true if the user wants to recover unsaved changes of the previous session.
+
+bool UserInteractor::onRecoveryRequest()
+{
+    QMessageBox msgBox;
+    msgBox.setText("The previous session has unsaved changes.");
+    msgBox.setInformativeText("Do you want to recover them?");
+    msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
+    msgBox.setDefaultButton(QMessageBox::Yes);
+    return msgBox.exec() == QMessageBox::Yes;
+}
+
 //! Summon dialog to select directory on disk. If selection is not empty,
 //! save parent directory for later re-use.
 
@@ -34,6 +34,8 @@ public:
 
     ModelView::SaveChangesAnswer onSaveChangesRequest();
 
+    bool onRecoveryRequest();
+
 private:
     std::string selectDir() const;
 
@@ -17,6 +17,8 @@
 //#include "Core/Multilayer/Layer.h"
 //#include "Core/Multilayer/MultiLayer.h"
 #include <minikernel/Parametrization/Units.h>
+#include <algorithm>
+#include <stdexcept>
 
 namespace
 {
@@ -80,6 +82,86 @@ std::vector<complex_t> KzComputation::computeKzFromRefIndices(const std::vector<
     return kz;
 }
 
+std::vector<std::vector<complex_t>>
+KzComputation::computeKzFromSLDs(const std::vector<BornAgain::Slice>& slices,
+                                 const std::vector<double>& kz)
+{
+    const size_t N = slices.size();
+    std::vector<std::vector<complex_t>> result(kz.size(), std::vector<complex_t>(N));
+    if (N == 0)
+        return result;
+
+    // SLDs relative to the fronting medium are the same for all scan points
+    const complex_t sld_ref = normalizedSLD(slices[0].material());
+    std::vector<complex_t> sld_diff(N);
+    for (size_t i = 1; i < N; ++i)
+        sld_diff[i] = sld_ref - normalizedSLD(slices[i].material());
+
+    for (size_t j = 0; j < kz.size(); ++j) {
+        const double kz_val = kz[j];
+        const double k_sign = kz_val > 0.0 ? -1 : 1;
+        const double kz2 = kz_val * kz_val;
+        auto& kz_slices = result[j];
+        kz_slices[0] = -kz_val;
+        for (size_t i = 1; i < N; ++i)
+            kz_slices[i] = k_sign * std::sqrt(checkForUnderflow(kz2 + sld_diff[i]));
+    }
+    return result;
+}
+
+std::vector<std::vector<complex_t>>
+KzComputation::computeKzFromRefIndices(const std::vector<BornAgain::Slice>& slices,
+                                       const std::vector<double>& alpha_i,
+                                       const std::vector<double>& wavelengths)
+{
+    if (alpha_i.size() != wavelengths.size())
+        throw std::runtime_error("Error in computeKzFromRefIndices: number of incidence angles "
+                                 "doesn't match number of wavelengths");
+
+    const size_t N = slices.size();
+    std::vector<std::vector<complex_t>> result(alpha_i.size(), std::vector<complex_t>(N));
+    if (N == 0)
+        return result;
+
+    // Slice::material() returns a copy, take materials out of slices only once
+    std::vector<Material> materials;
+    materials.reserve(N);
+    for (const auto& slice : slices)
+        materials.push_back(slice.material());
+
+    // distinct wavelengths of the scan
+    std::vector<double> wl_bins(wavelengths);
+    std::sort(wl_bins.begin(), wl_bins.end());
+    wl_bins.erase(std::unique(wl_bins.begin(), wl_bins.end()), wl_bins.end());
+
+    // squared refractive indices relative to the fronting medium, N values per wavelength bin
+    std::vector<complex_t> n2_norm(wl_bins.size() * N);
+    for (size_t bin = 0; bin < wl_bins.size(); ++bin) {
+        const complex_t n2_ref = materials[0].refractiveIndex2(wl_bins[bin]);
+        for (size_t i = 1; i < N; ++i)
+            n2_norm[bin * N + i] = materials[i].refractiveIndex2(wl_bins[bin]) - n2_ref;
+    }
+
+    for (size_t j = 0; j < alpha_i.size(); ++j) {
+        const double wl = wavelengths[j];
+        const size_t bin = static_cast<size_t>(
+            std::lower_bound(wl_bins.begin(), wl_bins.end(), wl) - wl_bins.begin());
+        const double k = 2 * M_PI / wl;
+        const double k2 = k * k;
+        // incoming beam propagates downwards
+        const double kz_val = -k * std::sin(alpha_i[j]);
+        const double k_sign = kz_val > 0.0 ? -1 : 1;
+        const double kz2 = kz_val * kz_val;
+
+        auto& kz_slices = result[j];
+        kz_slices[0] = -kz_val;
+        const complex_t* n2 = &n2_norm[bin * N];
+        for (size_t i = 1; i < N; ++i)
+            kz_slices[i] = k_sign * std::sqrt(checkForUnderflow(k2 * n2[i] + kz2));
+    }
+    return result;
+}
+
 namespace
 {
 complex_t normalizedSLD(const Material& material)
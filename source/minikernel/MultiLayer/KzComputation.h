@@ -51,6 +51,22 @@ BA_CORE_API_ std::vector<complex_t> computeKzFromSLDs(const std::vector<BornAgai
  */
 BA_CORE_API_ std::vector<complex_t> computeKzFromRefIndices(const std::vector<BornAgain::Slice>& slices,
                                                             kvector_t k);
+
+/* Computes kz values for a whole scan of incoming kz values known at a distant point in vacuum.
+ * Normalized SLDs of the slices are evaluated once and reused for every scan point.
+ * Returns one vector of kz values (one per slice) for each scan point.
+ */
+BA_CORE_API_ std::vector<std::vector<complex_t>>
+computeKzFromSLDs(const std::vector<BornAgain::Slice>& slices, const std::vector<double>& kz);
+
+/* Computes kz values for a wavelength-dispersive (time-of-flight) scan given by pairs of
+ * grazing incidence angles (in radians) and wavelengths. Material dispersion is evaluated once
+ * per distinct wavelength, scan points sharing the wavelength reuse it.
+ * Returns one vector of kz values (one per slice) for each scan point.
+ */
+BA_CORE_API_ std::vector<std::vector<complex_t>>
+computeKzFromRefIndices(const std::vector<BornAgain::Slice>& slices,
+                        const std::vector<double>& alpha_i, const std::vector<double>& wavelengths);
 } // namespace KzComputation
 
 #endif // BORNAGAIN_CORE_MULTILAYER_KZCOMPUTATION_H
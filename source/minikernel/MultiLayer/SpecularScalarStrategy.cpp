@@ -45,48 +45,99 @@ ISpecularStrategy::coeffs_t SpecularScalarStrategy::Execute(const std::vector<Bo
     return result;
 }
 
-std::vector<ScalarRTCoefficients>
-SpecularScalarStrategy::computeTR(const std::vector<BornAgain::Slice>& slices,
-                                  const std::vector<complex_t>& kz) const
+complex_t SpecularScalarStrategy::topLayerR(const std::vector<BornAgain::Slice>& slices,
+                                           const std::vector<complex_t>& kz) const
 {
+    if (slices.size() != kz.size())
+        throw std::runtime_error("Number of slices does not match the size of the kz-vector");
+
     const size_t N = slices.size();
-    std::vector<ScalarRTCoefficients> coeff(N);
+    if (N <= 1) // If only one layer present, there's nothing left to calculate
+        return 0.0;
+    else if (kz[0] == 0.0) // If kz in layer 0 is zero, R0 = -T0
+        return -1.0;
+
+    // Same bottom to top sweep as in calculateUpFromLayer, keeping only the current amplitudes.
+    // Forward correction of amplitudes isn't needed, since it doesn't affect the top layer.
+    Eigen::Vector2cd t_r(1.0, 0.0);
+    for (size_t j = 0; j <= N - 2; ++j) {
+        size_t i = N - 2 - j; // start from bottom
+        double sigma = 0.0;
+        if (const auto roughness = GetBottomRoughness(slices, i))
+            sigma = roughness->getSigma();
 
-    for (size_t i = 0; i < N; ++i)
-        coeff[i].kz = kz[i];
+        t_r = transition(kz[i], kz[i + 1], sigma, slices[i].thickness(), t_r);
+
+        if (std::isinf(std::norm(t_r(0))) || std::isnan(std::norm(t_r(0)))) {
+            t_r(0) = 1.0;
+            t_r(1) = 0.0;
+        }
 
-    if (N == 1) { // If only one layer present, there's nothing left to calculate
-        coeff[0].t_r = {1.0, 0.0};
-        return coeff;
+        t_r = t_r / t_r(0);
+    }
+    return t_r(1);
+}
+
+void SpecularScalarStrategy::computeAmplitudes(const std::vector<BornAgain::Slice>& slices,
+                                               const std::vector<complex_t>& kz,
+                                               std::vector<Eigen::Vector2cd>& t_r) const
+{
+    if (slices.size() != kz.size())
+        throw std::runtime_error("Number of slices does not match the size of the kz-vector");
+
+    const size_t N = slices.size();
+    if (t_r.size() != N)
+        t_r.resize(N);
+
+    if (N == 0) {
+        return;
+    } else if (N == 1) { // If only one layer present, there's nothing left to calculate
+        t_r[0] = {1.0, 0.0};
+        return;
     } else if (kz[0] == 0.0) { // If kz in layer 0 is zero, R0 = -T0 and all others equal to 0
-        coeff[0].t_r = {1.0, -1.0};
+        t_r[0] = {1.0, -1.0};
         for (size_t i = 1; i < N; ++i)
-            coeff[i].t_r.setZero();
-        return coeff;
+            t_r[i].setZero();
+        return;
     }
 
     // Calculate transmission/refraction coefficients t_r for each layer, from bottom to top.
     size_t start_index = N - 2;
-    calculateUpFromLayer(coeff, slices, kz, start_index);
+    calculateUpFromLayer(t_r, slices, kz, start_index);
+}
+
+std::vector<ScalarRTCoefficients>
+SpecularScalarStrategy::computeTR(const std::vector<BornAgain::Slice>& slices,
+                                  const std::vector<complex_t>& kz) const
+{
+    const size_t N = slices.size();
+    std::vector<ScalarRTCoefficients> coeff(N);
+
+    std::vector<Eigen::Vector2cd> t_r;
+    computeAmplitudes(slices, kz, t_r);
+
+    for (size_t i = 0; i < N; ++i) {
+        coeff[i].kz = kz[i];
+        coeff[i].t_r = t_r[i];
+    }
     return coeff;
 }
 
-void SpecularScalarStrategy::setZeroBelow(std::vector<ScalarRTCoefficients>& coeff,
-                                          size_t current_layer)
+void SpecularScalarStrategy::setZeroBelow(std::vector<Eigen::Vector2cd>& t_r, size_t current_layer)
 {
-    size_t N = coeff.size();
+    size_t N = t_r.size();
     for (size_t i = current_layer + 1; i < N; ++i) {
-        coeff[i].t_r.setZero();
+        t_r[i].setZero();
     }
 }
 
-bool SpecularScalarStrategy::calculateUpFromLayer(std::vector<ScalarRTCoefficients>& coeff,
+bool SpecularScalarStrategy::calculateUpFromLayer(std::vector<Eigen::Vector2cd>& t_r,
                                                   const std::vector<BornAgain::Slice>& slices,
                                                   const std::vector<complex_t>& kz,
                                                   size_t slice_index) const
 {
-    coeff[slice_index + 1].t_r(0) = 1.0;
-    coeff[slice_index + 1].t_r(1) = 0.0;
+    t_r[slice_index + 1](0) = 1.0;
+    t_r[slice_index + 1](1) = 0.0;
     std::vector<complex_t> factors(slice_index + 2);
     factors[slice_index + 1] = complex_t(1, 0);
     for (size_t j = 0; j <= slice_index; ++j) {
@@ -95,21 +146,21 @@ bool SpecularScalarStrategy::calculateUpFromLayer(std::vector<ScalarRTCoefficien
         if (const auto roughness = GetBottomRoughness(slices, i))
             sigma = roughness->getSigma();
 
-        coeff[i].t_r = transition(kz[i], kz[i + 1], sigma, slices[i].thickness(), coeff[i + 1].t_r);
+        t_r[i] = transition(kz[i], kz[i + 1], sigma, slices[i].thickness(), t_r[i + 1]);
 
-        if (std::isinf(std::norm(coeff[i].t_r(0))) || std::isnan(std::norm(coeff[i].t_r(0)))) {
-            coeff[i].t_r(0) = 1.0;
-            coeff[i].t_r(1) = 0.0;
+        if (std::isinf(std::norm(t_r[i](0))) || std::isnan(std::norm(t_r[i](0)))) {
+            t_r[i](0) = 1.0;
+            t_r[i](1) = 0.0;
 
-            setZeroBelow(coeff, i);
+            setZeroBelow(t_r, i);
         }
 
         // normalize the t-coefficient in each step of the computation
         // this avoids an overflow in the backwards propagation
         // the used factors are stored in order to correct the amplitudes
         // in forward direction at the end of the computation
-        factors[i] = coeff[i].t_r(0);
-        coeff[i].t_r = coeff[i].t_r / coeff[i].t_r(0);
+        factors[i] = t_r[i](0);
+        t_r[i] = t_r[i] / t_r[i](0);
     }
 
     // now correct all amplitudes by dividing the with the remaining factors in forward direction
@@ -119,10 +170,10 @@ bool SpecularScalarStrategy::calculateUpFromLayer(std::vector<ScalarRTCoefficien
     for (size_t j = 1; j <= slice_index + 1; ++j) {
         dumpingFactor = dumpingFactor * factors[j - 1];
         if (std::isinf(std::norm(dumpingFactor))) {
-            setZeroBelow(coeff, j - 1);
+            setZeroBelow(t_r, j - 1);
             break;
         }
-        coeff[j].t_r = coeff[j].t_r / dumpingFactor;
+        t_r[j] = t_r[j] / dumpingFactor;
     }
 
     // this return value is meaningless now, this procedure should always succeed
@@ -44,6 +44,17 @@ public:
     virtual ISpecularStrategy::coeffs_t Execute(const std::vector<BornAgain::Slice>& slices,
                                                 const std::vector<complex_t>& kz) const override;
 
+    //! Computes reflection amplitude on top of the multilayer only. Doesn't create
+    //! coefficient objects and doesn't store amplitudes of the layers below.
+    complex_t topLayerR(const std::vector<BornAgain::Slice>& slices,
+                        const std::vector<complex_t>& kz) const;
+
+    //! Computes transmission/reflection amplitudes t_r of all layers and writes them into
+    //! caller-provided buffer. Buffer is resized only if its size doesn't match number of slices,
+    //! so it can be reused between calls.
+    void computeAmplitudes(const std::vector<BornAgain::Slice>& slices,
+                           const std::vector<complex_t>& kz, std::vector<Eigen::Vector2cd>& t_r) const;
+
 private:
     virtual Eigen::Vector2cd transition(complex_t kzi, complex_t kzi1, double sigma,
                                         double thickness, const Eigen::Vector2cd& t_r1) const = 0;
@@ -51,9 +62,9 @@ private:
     std::vector<ScalarRTCoefficients> computeTR(const std::vector<BornAgain::Slice>& slices,
                                                 const std::vector<complex_t>& kz) const;
 
-    static void setZeroBelow(std::vector<ScalarRTCoefficients>& coeff, size_t current_layer);
+    static void setZeroBelow(std::vector<Eigen::Vector2cd>& t_r, size_t current_layer);
 
-    bool calculateUpFromLayer(std::vector<ScalarRTCoefficients>& coeff,
+    bool calculateUpFromLayer(std::vector<Eigen::Vector2cd>& t_r,
                               const std::vector<BornAgain::Slice>& slices, const std::vector<complex_t>& kz,
                               size_t slice_index) const;
 };
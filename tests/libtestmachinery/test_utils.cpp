@@ -72,3 +72,18 @@ std::string TestUtils::CreateEmptyFile(const std::string& dirname, const std::st
                                  "Can't create file");
     return filename;
 }
+
+std::string TestUtils::WriteTestFile(const std::string& test_sub_dir, const std::string& file_name,
+                                     const std::string& content)
+{
+    CreateTestDirectory(test_sub_dir);
+    auto filename = TestFileName(test_sub_dir, file_name);
+
+    QFile file(QString::fromStdString(filename));
+    if (!file.open(QIODevice::WriteOnly)
+        || file.write(content.data(), static_cast<qint64>(content.size()))
+               != static_cast<qint64>(content.size()))
+        throw std::runtime_error("TestUtils::WriteTestFile() -> Error. Can't write file");
+
+    return filename;
+}
@@ -52,6 +52,11 @@ std::string CreateTestFile(const std::string& dirname, const std::string& fileNa
 //! Returns full path of the file.
 std::string CreateEmptyFile(const std::string& dirname, const std::string& fileName);
 
+//! Creates test directory in main test folder and writes the file with given raw content into it.
+//! Returns full path of the file.
+std::string WriteTestFile(const std::string& test_sub_dir, const std::string& file_name,
+                          const std::string& content);
+
 } // namespace TestUtils
 
 #endif
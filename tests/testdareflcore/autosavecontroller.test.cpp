@@ -0,0 +1,210 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include "test_utils.h"
+#include <QDir>
+#include <QTest>
+#include <darefl/model/applicationmodels.h>
+#include <darefl/model/experimentaldata_types.h>
+#include <darefl/model/experimentaldataitems.h>
+#include <darefl/model/experimentaldatamodel.h>
+#include <darefl/model/instrumentmodel.h>
+#include <darefl/model/materialitems.h>
+#include <darefl/model/materialmodel.h>
+#include <darefl/model/samplemodel.h>
+#include <darefl/welcomeview/autosavecontroller.h>
+#include <fstream>
+#include <mvvm/model/modelutils.h>
+#include <mvvm/standarditems/data1ditem.h>
+#include <mvvm/standarditems/graphitem.h>
+
+using namespace ModelView;
+
+//! Tests of AutosaveController.
+
+class AutosaveControllerTest : public ::testing::Test
+{
+public:
+    ~AutosaveControllerTest();
+
+    static inline const int interval_msec = 10;
+    static inline const int wait_msec = 200; //! enough for the autosave timer to fire
+
+    //! Returns empty directory for journals.
+    static std::string journalDir(const std::string& test_sub_dir)
+    {
+        auto path = TestUtils::TestDirectoryPath(test_sub_dir);
+        QDir(QString::fromStdString(path)).removeRecursively();
+        return TestUtils::CreateTestDirectory(test_sub_dir);
+    }
+
+    //! Returns the number of journal records of the model.
+    static int recordCount(const std::string& file_name, const std::string& model_type)
+    {
+        int result{0};
+        std::ifstream file(file_name);
+        for (std::string line; std::getline(file, line);)
+            if (line.rfind(model_type + "\t", 0) == 0)
+                ++result;
+        return result;
+    }
+
+    static std::string projectDir() { return "/projects/recovery"; }
+};
+
+AutosaveControllerTest::~AutosaveControllerTest() = default;
+
+//! Only models changed since the last autosave are written.
+
+TEST_F(AutosaveControllerTest, dirtyModels)
+{
+    const auto dir = journalDir("autosavecontroller_dirty");
+    ApplicationModels models;
+    std::string file_name;
+    {
+        AutosaveController controller(&models, dir, &projectDir);
+        controller.setInterval(interval_msec);
+        file_name = controller.journalFileName();
+        EXPECT_FALSE(controller.hasRecoveryData());
+
+        auto material = models.materialModel()->addDefaultMaterial();
+        material->setProperty(MaterialBaseItem::P_NAME, std::string("changed"));
+        QTest::qWait(wait_msec);
+    }
+
+    auto records = AutosaveJournal::read(file_name);
+    EXPECT_EQ(1, records.count(models.materialModel()->modelType()));
+    EXPECT_EQ(0, records.count(models.sampleModel()->modelType()));
+    EXPECT_EQ(0, records.count(models.instrumentModel()->modelType()));
+    EXPECT_EQ(0, records.count(models.experimentalDataModel()->modelType()));
+}
+
+//! Changes made during the autosave interval are written at once, when the interval is over.
+
+TEST_F(AutosaveControllerTest, throttling)
+{
+    const auto dir = journalDir("autosavecontroller_throttling");
+    ApplicationModels models;
+    const auto model_type = models.materialModel()->modelType();
+    std::string file_name;
+    {
+        AutosaveController controller(&models, dir, &projectDir);
+        controller.setInterval(interval_msec);
+        file_name = controller.journalFileName();
+
+        auto material = models.materialModel()->addDefaultMaterial();
+        for (int i = 0; i < 5; ++i)
+            material->setProperty(MaterialBaseItem::P_NAME, "first" + std::to_string(i));
+        EXPECT_EQ(0, recordCount(file_name, model_type));
+        QTest::qWait(wait_msec);
+
+        for (int i = 0; i < 5; ++i)
+            material->setProperty(MaterialBaseItem::P_NAME, "second" + std::to_string(i));
+        QTest::qWait(wait_msec);
+    }
+
+    EXPECT_EQ(2, recordCount(file_name, model_type));
+}
+
+//! Changes left by the previous session are recovered, together with their project directory.
+
+TEST_F(AutosaveControllerTest, recover)
+{
+    const auto dir = journalDir("autosavecontroller_recover");
+    std::string identifier;
+    {
+        ApplicationModels models;
+        AutosaveController controller(&models, dir, &projectDir);
+        controller.setInterval(interval_msec);
+
+        auto material = models.materialModel()->addDefaultMaterial();
+        material->setProperty(MaterialBaseItem::P_NAME, std::string("recovered"));
+        identifier = material->identifier();
+        QTest::qWait(wait_msec);
+    }
+
+    ApplicationModels models;
+    AutosaveController controller(&models, dir);
+    ASSERT_TRUE(controller.hasRecoveryData());
+    EXPECT_EQ(projectDir(), controller.recoveryProjectDir());
+    EXPECT_EQ(nullptr, models.materialModel()->findItem(identifier));
+
+    controller.recover();
+    EXPECT_FALSE(controller.hasRecoveryData());
+    auto material = models.materialModel()->findItem(identifier);
+    ASSERT_NE(nullptr, material);
+    EXPECT_EQ("recovered", material->property<std::string>(MaterialBaseItem::P_NAME));
+}
+
+//! Full-resolution data of decimated datasets is recovered. Updates of decimated views aren't
+//! autosaved.
+
+TEST_F(AutosaveControllerTest, recoverDataStore)
+{
+    const auto dir = journalDir("autosavecontroller_datastore");
+    const int n_points = 20000;
+    RealDataStruct data_struct;
+    for (int i = 0; i < n_points; ++i) {
+        data_struct.axis.push_back(i);
+        data_struct.data.push_back(1.0 / (1.0 + i));
+    }
+    std::string identifier;
+    {
+        ApplicationModels models;
+        AutosaveController controller(&models, dir, &projectDir);
+        controller.setInterval(interval_msec);
+
+        auto model = models.experimentalDataModel();
+        auto canvas = model->addDataToCollection(
+            data_struct, Utils::TopItem<CanvasContainerItem>(model));
+        auto data = canvas->graphItems().at(0)->dataItem();
+        ASSERT_TRUE(model->isDecimated(data));
+        identifier = data->identifier();
+        QTest::qWait(wait_msec);
+
+        const auto file_name = controller.journalFileName();
+        EXPECT_EQ(1, recordCount(file_name, model->modelType()));
+        model->updateDataView(data, 100.0, 200.0, 50);
+        QTest::qWait(wait_msec);
+        EXPECT_EQ(1, recordCount(file_name, model->modelType()));
+    }
+
+    ApplicationModels models;
+    AutosaveController controller(&models, dir);
+    ASSERT_TRUE(controller.hasRecoveryData());
+    controller.recover();
+
+    auto model = models.experimentalDataModel();
+    auto data = dynamic_cast<Data1DItem*>(model->findItem(identifier));
+    ASSERT_NE(nullptr, data);
+    EXPECT_TRUE(model->isDecimated(data));
+    EXPECT_EQ(data_struct.axis, model->sourceAxis(data));
+    EXPECT_EQ(data_struct.data, model->sourceValues(data));
+}
+
+//! Running instances don't share the journal.
+
+TEST_F(AutosaveControllerTest, journalPerInstance)
+{
+    const auto dir = journalDir("autosavecontroller_instances");
+    ApplicationModels models1;
+    ApplicationModels models2;
+    std::string file_name1;
+    {
+        AutosaveController controller1(&models1, dir);
+        AutosaveController controller2(&models2, dir);
+        file_name1 = controller1.journalFileName();
+        EXPECT_NE(file_name1, controller2.journalFileName());
+    }
+
+    // the journal is released with its controller
+    AutosaveController controller3(&models1, dir);
+    EXPECT_EQ(file_name1, controller3.journalFileName());
+}
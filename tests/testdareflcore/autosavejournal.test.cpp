@@ -0,0 +1,75 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include "test_utils.h"
+#include <darefl/welcomeview/autosavejournal.h>
+#include <fstream>
+
+//! Tests of AutosaveJournal.
+
+class AutosaveJournalTest : public ::testing::Test
+{
+public:
+    ~AutosaveJournalTest();
+};
+
+AutosaveJournalTest::~AutosaveJournalTest() = default;
+
+//! The latest record of every model is recovered, an incomplete line is ignored.
+
+TEST_F(AutosaveJournalTest, appendRead)
+{
+    TestUtils::CreateTestDirectory("autosavejournal");
+    const auto file_name = TestUtils::TestFileName("autosavejournal", "append.journal");
+
+    {
+        AutosaveJournal journal(file_name);
+        journal.clear();
+        journal.append({{"SampleModel", "{\"a\":1}"}, {"MaterialModel", "{\"b\":1}"}});
+        journal.append({{"SampleModel", "{\"a\":2}"}});
+    }
+    std::ofstream(file_name, std::ios::app) << "MaterialModel\t{\"b\":";
+
+    auto records = AutosaveJournal::read(file_name);
+    EXPECT_EQ(records.size(), 2u);
+    EXPECT_EQ(records["SampleModel"], "{\"a\":2}");
+    EXPECT_EQ(records["MaterialModel"], "{\"b\":1}");
+
+    // nothing to recover after clear
+    AutosaveJournal journal(file_name);
+    journal.clear();
+    journal.wait();
+    EXPECT_TRUE(AutosaveJournal::read(file_name).empty());
+}
+
+//! Long journal is compacted to the latest records.
+
+TEST_F(AutosaveJournalTest, compaction)
+{
+    TestUtils::CreateTestDirectory("autosavejournal");
+    const auto file_name = TestUtils::TestFileName("autosavejournal", "compaction.journal");
+
+    AutosaveJournal journal(file_name, 10);
+    journal.clear();
+    journal.append({{"MaterialModel", "m"}});
+    for (int i = 0; i < 100; ++i)
+        journal.append({{"SampleModel", std::to_string(i)}});
+    journal.wait();
+
+    std::ifstream file(file_name);
+    size_t line_count{0};
+    for (std::string line; std::getline(file, line);)
+        ++line_count;
+    EXPECT_LE(line_count, 11u);
+
+    auto records = AutosaveJournal::read(file_name);
+    EXPECT_EQ(records["MaterialModel"], "m");
+    EXPECT_EQ(records["SampleModel"], "99");
+}
@@ -0,0 +1,65 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include <algorithm>
+#include <cmath>
+#include <darefl/model/datadecimation.h>
+#include <limits>
+
+//! Tests of min/max preserving decimation.
+
+class DataDecimationTest : public ::testing::Test
+{
+public:
+    ~DataDecimationTest();
+};
+
+DataDecimationTest::~DataDecimationTest() = default;
+
+//! All points are kept if there are only a few of them in the range.
+
+TEST_F(DataDecimationTest, fewPoints)
+{
+    std::vector<double> x{0.0, 1.0, 2.0, 3.0, 4.0, 5.0};
+    std::vector<double> y{1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+
+    EXPECT_EQ(Utils::MinMaxDecimation(x, y, 0.0, 5.0, 10), std::vector<size_t>({0, 1, 2, 3, 4, 5}));
+
+    // nearest points outside of the range are included
+    EXPECT_EQ(Utils::MinMaxDecimation(x, y, 1.5, 3.5, 10), std::vector<size_t>({1, 2, 3, 4}));
+    EXPECT_EQ(Utils::MinMaxDecimation(x, y, 10.0, 20.0, 10), std::vector<size_t>({5}));
+    EXPECT_TRUE(Utils::MinMaxDecimation({}, {}, 0.0, 1.0, 10).empty());
+}
+
+//! Every column keeps its first, last, minimum and maximum points.
+
+TEST_F(DataDecimationTest, envelope)
+{
+    const size_t size = 10000;
+    std::vector<double> x, y;
+    for (size_t i = 0; i < size; ++i) {
+        x.push_back(static_cast<double>(i));
+        y.push_back(std::sin(0.1 * i) * (i == 5003 ? 10.0 : 1.0));
+    }
+
+    const int n_columns = 100;
+    auto indices = Utils::MinMaxDecimation(x, y, 0.0, static_cast<double>(size - 1), n_columns);
+    EXPECT_LE(indices.size(), 4 * static_cast<size_t>(n_columns) + 4);
+    EXPECT_TRUE(std::is_sorted(indices.begin(), indices.end()));
+    EXPECT_EQ(indices.front(), 0u);
+    EXPECT_EQ(indices.back(), size - 1);
+
+    // the spike survives decimation
+    EXPECT_NE(std::find(indices.begin(), indices.end(), 5003u), indices.end());
+
+    // infinite range is equivalent to the range of the data
+    const double inf = std::numeric_limits<double>::infinity();
+    EXPECT_EQ(Utils::MinMaxDecimation(x, y, -inf, inf, n_columns), indices);
+}
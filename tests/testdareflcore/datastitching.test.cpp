@@ -0,0 +1,94 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include <darefl/model/datastitching.h>
+#include <cmath>
+
+using namespace DataStitching;
+
+//! Tests of DataStitching utils.
+
+class DataStitchingTest : public ::testing::Test
+{
+public:
+    ~DataStitchingTest();
+
+    //! Returns exponentially decaying curve on `n_points` points in [qmin, qmax].
+    static Curve createCurve(double qmin, double qmax, int n_points, double scale = 1.0)
+    {
+        Curve result;
+        for (int i = 0; i < n_points; ++i) {
+            const double q = qmin + (qmax - qmin) * i / (n_points - 1);
+            result.axis.push_back(q);
+            result.values.push_back(scale * std::exp(-20.0 * q));
+        }
+        return result;
+    }
+};
+
+DataStitchingTest::~DataStitchingTest() = default;
+
+//! Scale factor of the curve measured with a different intensity.
+
+TEST_F(DataStitchingTest, scaleFactor)
+{
+    auto reference = createCurve(0.01, 0.1, 91);
+    auto curve = createCurve(0.05, 0.2, 31, 4.0);
+    EXPECT_NEAR(ScaleFactor(reference, curve), 0.25, 1e-3);
+
+    // curves without overlap aren't scaled
+    auto distant = createCurve(0.3, 0.4, 11, 4.0);
+    EXPECT_EQ(ScaleFactor(reference, distant), 1.0);
+}
+
+//! Log-spaced bin edges.
+
+TEST_F(DataStitchingTest, binEdges)
+{
+    auto edges = BinEdges(0.01, 1.0, 2);
+    ASSERT_EQ(edges.size(), 3u);
+    EXPECT_DOUBLE_EQ(edges.front(), 0.01);
+    EXPECT_NEAR(edges[1], 0.1, 1e-12);
+    EXPECT_DOUBLE_EQ(edges.back(), 1.0);
+}
+
+//! Error-weighted average of points falling into one bin.
+
+TEST_F(DataStitchingTest, rebin)
+{
+    Curve curve{{1.0, 1.5, 2.5, 3.0}, {1.0, 3.0, 5.0, 5.0}, {1.0, 1.0, 1.0, 2.0}};
+    auto result = Rebin(curve, {1.0, 2.0, 3.0});
+    ASSERT_EQ(result.axis.size(), 2u);
+    EXPECT_DOUBLE_EQ(result.axis[0], 1.25);
+    EXPECT_DOUBLE_EQ(result.values[0], 2.0);
+    EXPECT_DOUBLE_EQ(result.values[1], 5.0);
+    ASSERT_EQ(result.errors.size(), 2u);
+    EXPECT_DOUBLE_EQ(result.errors[0], 1.0 / std::sqrt(2.0));
+}
+
+//! Stitching of two overlapping curves measured with different intensities.
+
+TEST_F(DataStitchingTest, stitch)
+{
+    auto high_q = createCurve(0.08, 0.3, 45, 10.0);
+    auto low_q = createCurve(0.01, 0.1, 46);
+
+    auto result = Stitch({high_q, low_q, Curve{}}, 50);
+    ASSERT_FALSE(result.axis.empty());
+    EXPECT_LE(result.axis.size(), 50u);
+    EXPECT_NEAR(result.axis.front(), 0.01, 1e-3);
+    EXPECT_NEAR(result.axis.back(), 0.3, 1e-2);
+    for (size_t i = 0; i < result.axis.size(); ++i) {
+        EXPECT_NEAR(result.values[i], std::exp(-20.0 * result.axis[i]), 0.05 * result.values[i]);
+        if (i > 0) {
+            EXPECT_LT(result.axis[i - 1], result.axis[i]);
+        }
+    }
+}
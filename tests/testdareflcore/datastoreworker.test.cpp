@@ -0,0 +1,130 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include "test_utils.h"
+#include <darefl/model/experimentaldatastore.h>
+#include <darefl/welcomeview/datastoreworker.h>
+
+//! Tests of DataStoreWorker.
+
+class DataStoreWorkerTest : public ::testing::Test
+{
+public:
+    ~DataStoreWorkerTest();
+
+    static std::string testPath(const std::string& name)
+    {
+        TestUtils::CreateTestDirectory("datastoreworker");
+        return TestUtils::TestFileName("datastoreworker", name);
+    }
+
+    //! Returns entries with given keys, each with a single point.
+    static ExperimentalDataStore::entries_t entries(const std::vector<std::string>& keys)
+    {
+        ExperimentalDataStore store;
+        for (const auto& key : keys)
+            store.insert(key, {1.0}, {2.0});
+        return store.entries(keys);
+    }
+
+    static std::vector<std::string> keys(const ExperimentalDataStore::entries_t& entries)
+    {
+        std::vector<std::string> result;
+        for (const auto& entry : entries)
+            result.push_back(entry.first);
+        return result;
+    }
+
+    static std::vector<std::string> keysInFile(const std::string& file_name)
+    {
+        ExperimentalDataStore::entries_t result;
+        ExperimentalDataStore::read(file_name, result);
+        return keys(result);
+    }
+};
+
+DataStoreWorkerTest::~DataStoreWorkerTest() = default;
+
+//! Requests are served in the order they were made, the load reads what was saved before it.
+
+TEST_F(DataStoreWorkerTest, requestOrder)
+{
+    const auto file_name = testPath("order.bin");
+    DataStoreWorker worker;
+    worker.save(file_name, entries({"a"}));
+    worker.save(file_name, entries({"a", "b"}));
+    worker.load(file_name);
+    worker.wait();
+
+    auto loaded = worker.takeLoadedEntries();
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(keys(*loaded), std::vector<std::string>({"a", "b"}));
+
+    // the result is taken only once
+    EXPECT_FALSE(worker.takeLoadedEntries().has_value());
+}
+
+//! Only the result of the last load request is reported, discarded loads aren't reported.
+
+TEST_F(DataStoreWorkerTest, staleLoads)
+{
+    const auto file_name1 = testPath("stale1.bin");
+    const auto file_name2 = testPath("stale2.bin");
+    ASSERT_TRUE(ExperimentalDataStore::write(file_name1, entries({"a"})));
+    ASSERT_TRUE(ExperimentalDataStore::write(file_name2, entries({"b"})));
+
+    DataStoreWorker worker;
+    worker.load(file_name1);
+    worker.load(file_name2);
+    worker.wait();
+    auto loaded = worker.takeLoadedEntries();
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(keys(*loaded), std::vector<std::string>({"b"}));
+
+    worker.load(file_name1);
+    worker.discardLoad();
+    worker.wait();
+    EXPECT_FALSE(worker.takeLoadedEntries().has_value());
+}
+
+//! Saving before the loaded data was taken writes the loaded data too.
+
+TEST_F(DataStoreWorkerTest, saveWhileLoading)
+{
+    const auto project_file = testPath("project.bin");
+    const auto copy_file = testPath("copy.bin");
+    const auto later_file = testPath("later.bin");
+    ASSERT_TRUE(ExperimentalDataStore::write(project_file, entries({"a", "b"})));
+
+    DataStoreWorker worker;
+    worker.load(project_file);
+    worker.save(copy_file, entries({"b", "c"}));
+    worker.wait();
+    EXPECT_EQ(keysInFile(copy_file), std::vector<std::string>({"b", "c", "a"}));
+
+    // taken data is part of the model, it is not added anymore
+    EXPECT_TRUE(worker.takeLoadedEntries().has_value());
+    worker.save(later_file, entries({"c"}));
+    worker.wait();
+    EXPECT_EQ(keysInFile(later_file), std::vector<std::string>({"c"}));
+}
+
+//! Destructor serves pending requests before stopping the thread.
+
+TEST_F(DataStoreWorkerTest, destructorDrains)
+{
+    const auto file_name = testPath("drain.bin");
+    {
+        DataStoreWorker worker;
+        worker.save(file_name, entries({"x"}));
+        worker.save(file_name, entries({"x", "y"}));
+    }
+    EXPECT_EQ(keysInFile(file_name), std::vector<std::string>({"x", "y"}));
+}
@@ -0,0 +1,183 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include <darefl/model/edithistory.h>
+#include <darefl/model/layeritems.h>
+#include <darefl/model/materialitems.h>
+#include <darefl/model/materialmodel.h>
+#include <darefl/model/materialpropertycontroller.h>
+#include <darefl/model/samplemodel.h>
+#include <mvvm/model/externalproperty.h>
+#include <mvvm/model/modelutils.h>
+
+using namespace ModelView;
+
+//! Tests of EditHistory.
+
+class EditHistoryTest : public ::testing::Test
+{
+public:
+    ~EditHistoryTest();
+};
+
+EditHistoryTest::~EditHistoryTest() = default;
+
+//! Property changes of both models are undone in reverse order, a new change drops undone steps.
+
+TEST_F(EditHistoryTest, undoRedo)
+{
+    MaterialModel material_model;
+    SampleModel sample_model;
+    auto multilayer = sample_model.insertItem<MultiLayerItem>();
+    auto layer = sample_model.insertItem<LayerItem>(multilayer);
+    layer->setProperty(LayerItem::P_THICKNESS, 10.0);
+
+    EditHistory history({&material_model, &sample_model});
+    EXPECT_FALSE(history.canUndo());
+
+    auto material = Utils::TopItem<MaterialContainerItem>(&material_model)->children().at(0);
+    const auto sld = material->property<double>(SLDMaterialItem::P_SLD_REAL);
+    layer->setProperty(LayerItem::P_THICKNESS, 20.0);
+    material->setProperty(SLDMaterialItem::P_SLD_REAL, 1.0);
+    layer->setProperty(LayerItem::P_THICKNESS, 30.0);
+
+    history.undo();
+    EXPECT_EQ(layer->property<double>(LayerItem::P_THICKNESS), 20.0);
+    EXPECT_EQ(material->property<double>(SLDMaterialItem::P_SLD_REAL), 1.0);
+    history.undo();
+    EXPECT_EQ(material->property<double>(SLDMaterialItem::P_SLD_REAL), sld);
+    EXPECT_EQ(layer->property<double>(LayerItem::P_THICKNESS), 20.0);
+    history.undo();
+    EXPECT_EQ(layer->property<double>(LayerItem::P_THICKNESS), 10.0);
+    EXPECT_FALSE(history.canUndo());
+
+    history.redo();
+    history.redo();
+    EXPECT_EQ(layer->property<double>(LayerItem::P_THICKNESS), 20.0);
+    EXPECT_EQ(material->property<double>(SLDMaterialItem::P_SLD_REAL), 1.0);
+
+    layer->setProperty(LayerItem::P_THICKNESS, 40.0);
+    EXPECT_FALSE(history.canRedo());
+    history.undo();
+    EXPECT_EQ(layer->property<double>(LayerItem::P_THICKNESS), 20.0);
+}
+
+//! Insertion and removal of layers are undone.
+
+TEST_F(EditHistoryTest, insertRemove)
+{
+    MaterialModel material_model;
+    SampleModel sample_model;
+    auto multilayer = sample_model.insertItem<MultiLayerItem>();
+    sample_model.insertItem<LayerItem>(multilayer);
+
+    EditHistory history({&material_model, &sample_model});
+    auto layer = sample_model.insertItem<LayerItem>(multilayer);
+    layer->setProperty(LayerItem::P_THICKNESS, 42.0);
+    EXPECT_EQ(multilayer->items<LayerItem>(MultiLayerItem::T_LAYERS).size(), 2u);
+
+    sample_model.removeItem(multilayer, layer->tagRow());
+    EXPECT_EQ(multilayer->items<LayerItem>(MultiLayerItem::T_LAYERS).size(), 1u);
+
+    history.undo();
+    auto layers = multilayer->items<LayerItem>(MultiLayerItem::T_LAYERS);
+    ASSERT_EQ(layers.size(), 2u);
+    EXPECT_EQ(layers.back()->property<double>(LayerItem::P_THICKNESS), 42.0);
+
+    history.undo();
+    history.undo();
+    EXPECT_EQ(multilayer->items<LayerItem>(MultiLayerItem::T_LAYERS).size(), 1u);
+    EXPECT_FALSE(history.canUndo());
+}
+
+//! Changes within a macro are undone in one step, a macro without changes leaves no step.
+
+TEST_F(EditHistoryTest, macro)
+{
+    MaterialModel material_model;
+    SampleModel sample_model;
+    auto multilayer = sample_model.insertItem<MultiLayerItem>();
+    auto layer = sample_model.insertItem<LayerItem>(multilayer);
+    layer->setProperty(LayerItem::P_THICKNESS, 10.0);
+
+    EditHistory history({&material_model, &sample_model});
+    int change_count{0};
+    history.setOnChange([&change_count]() { ++change_count; });
+
+    history.beginMacro();
+    history.endMacro();
+    EXPECT_FALSE(history.canUndo());
+
+    auto material = Utils::TopItem<MaterialContainerItem>(&material_model)->children().at(0);
+    const auto sld = material->property<double>(SLDMaterialItem::P_SLD_REAL);
+    history.beginMacro();
+    for (int i = 1; i <= 50; ++i)
+        layer->setProperty(LayerItem::P_THICKNESS, 10.0 + i);
+    material->setProperty(SLDMaterialItem::P_SLD_REAL, 1.0);
+    history.endMacro();
+    EXPECT_EQ(change_count, 4);
+
+    history.undo();
+    EXPECT_EQ(layer->property<double>(LayerItem::P_THICKNESS), 10.0);
+    EXPECT_EQ(material->property<double>(SLDMaterialItem::P_SLD_REAL), sld);
+    EXPECT_FALSE(history.canUndo());
+
+    history.redo();
+    EXPECT_EQ(layer->property<double>(LayerItem::P_THICKNESS), 60.0);
+    EXPECT_EQ(material->property<double>(SLDMaterialItem::P_SLD_REAL), 1.0);
+}
+
+//! The oldest steps are dropped when the limit is reached.
+
+TEST_F(EditHistoryTest, undoLimit)
+{
+    MaterialModel material_model;
+    SampleModel sample_model;
+    auto multilayer = sample_model.insertItem<MultiLayerItem>();
+    auto layer = sample_model.insertItem<LayerItem>(multilayer);
+
+    EditHistory history({&material_model, &sample_model}, 10);
+    for (int i = 1; i <= 100; ++i)
+        layer->setProperty(LayerItem::P_THICKNESS, static_cast<double>(i));
+
+    int undo_count{0};
+    for (; history.canUndo(); ++undo_count)
+        history.undo();
+    EXPECT_EQ(undo_count, 10);
+    EXPECT_EQ(layer->property<double>(LayerItem::P_THICKNESS), 90.0);
+}
+
+//! Layer labels follow undo and redo of material edits without steps of their own.
+
+TEST_F(EditHistoryTest, materialLabels)
+{
+    MaterialModel material_model;
+    SampleModel sample_model;
+    auto multilayer = sample_model.insertItem<MultiLayerItem>();
+    auto layer = sample_model.insertItem<LayerItem>(multilayer);
+    auto material = Utils::TopItem<MaterialContainerItem>(&material_model)
+                        ->items<SLDMaterialItem>(MaterialContainerItem::T_MATERIALS)
+                        .at(0);
+    layer->setProperty(LayerItem::P_MATERIAL, material->external_property());
+    MaterialPropertyController controller(&material_model, &sample_model);
+
+    EditHistory history({&material_model, &sample_model});
+    const auto name = material->property<std::string>(MaterialBaseItem::P_NAME);
+    material->setProperty(MaterialBaseItem::P_NAME, std::string("renamed"));
+    EXPECT_EQ(layer->property<ExternalProperty>(LayerItem::P_MATERIAL).text(), "renamed");
+
+    history.undo();
+    EXPECT_EQ(layer->property<ExternalProperty>(LayerItem::P_MATERIAL).text(), name);
+    EXPECT_FALSE(history.canUndo());
+
+    history.redo();
+    EXPECT_EQ(layer->property<ExternalProperty>(LayerItem::P_MATERIAL).text(), "renamed");
+    EXPECT_FALSE(history.canRedo());
+}
@@ -0,0 +1,130 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+
+#include <darefl/model/experimentaldata_types.h>
+#include <darefl/model/experimentaldatacontroller.h>
+#include <darefl/model/experimentaldataitems.h>
+#include <darefl/model/experimentaldatamodel.h>
+#include <darefl/model/instrumentitems.h>
+#include <darefl/model/instrumentmodel.h>
+#include <darefl/model/modelutils.h>
+
+#include <mvvm/model/externalproperty.h>
+#include <mvvm/model/modelutils.h>
+#include <mvvm/signals/modellistener.h>
+#include <mvvm/standarditems/graphitem.h>
+
+using namespace ModelView;
+
+//! Tests of ExperimentalDataController.
+
+class ExperimentalDataControllerTest : public ::testing::Test
+{
+public:
+    ~ExperimentalDataControllerTest();
+
+    RealDataStruct getRealDataStruct() const
+    {
+        RealDataStruct output;
+        output.name = "path";
+        output.data_name = "data_name";
+        output.axis = std::vector<double>{0, 1, 2, 3, 4};
+        output.data = std::vector<double>{0, 1, 2, 3, 4};
+        return output;
+    }
+
+    static ExternalProperty linkedProperty(const ExperimentalScanItem* scan)
+    {
+        return scan->property<ExternalProperty>(ExperimentalScanItem::P_IMPORTED_DATA);
+    }
+};
+
+ExperimentalDataControllerTest::~ExperimentalDataControllerTest() = default;
+
+//! Renaming the canvas updates the links of scans to its graphs.
+
+TEST_F(ExperimentalDataControllerTest, canvasRename)
+{
+    ExperimentalDataModel data_model;
+    InstrumentModel instrument_model;
+    ExperimentalDataController controller(&data_model, &instrument_model);
+
+    auto canvas = data_model.addDataToCollection(getRealDataStruct(), data_model.canvasContainer());
+    auto graph = canvas->graphItems().front();
+    auto scan = instrument_model.insertItem<ExperimentalScanItem>();
+    scan->setGraphItem(graph);
+
+    canvas->setDisplayName("renamed");
+    EXPECT_EQ(::Utils::CreateProperty(graph), linkedProperty(scan));
+    EXPECT_EQ("renamed/data_name", linkedProperty(scan).text());
+}
+
+//! Removing the graph, or the canvas containing it, unlinks the scans.
+
+TEST_F(ExperimentalDataControllerTest, graphRemoval)
+{
+    ExperimentalDataModel data_model;
+    InstrumentModel instrument_model;
+    ExperimentalDataController controller(&data_model, &instrument_model);
+
+    std::vector<RealDataStruct> data_structs(2, getRealDataStruct());
+    auto canvas = data_model.addDataToCollection(data_structs, data_model.canvasContainer());
+    auto graphs = canvas->graphItems();
+    ASSERT_EQ(2, graphs.size());
+    auto scan0 = instrument_model.insertItem<ExperimentalScanItem>();
+    scan0->setGraphItem(graphs.at(0));
+    auto scan1 = instrument_model.insertItem<ExperimentalScanItem>();
+    scan1->setGraphItem(graphs.at(1));
+    const auto link1 = linkedProperty(scan1);
+
+    data_model.removeDataFromCollection({graphs.at(0)});
+    EXPECT_EQ(ExternalProperty::undefined(), linkedProperty(scan0));
+    EXPECT_EQ(link1, linkedProperty(scan1));
+
+    data_model.removeDataFromCollection({canvas});
+    EXPECT_EQ(ExternalProperty::undefined(), linkedProperty(scan1));
+}
+
+//! Changes during a batch insertion are skipped, and the links are updated once afterwards.
+
+TEST_F(ExperimentalDataControllerTest, batchInsertion)
+{
+    ExperimentalDataModel data_model;
+    InstrumentModel instrument_model;
+    ExperimentalDataController controller(&data_model, &instrument_model);
+
+    auto canvas = data_model.addDataToCollection(getRealDataStruct(), data_model.canvasContainer());
+    auto graph = canvas->graphItems().front();
+    auto scan = instrument_model.insertItem<ExperimentalScanItem>();
+    scan->setGraphItem(graph);
+    const auto link = linkedProperty(scan);
+
+    // renames the canvas in the middle of the batch, after the controller got notified
+    ExternalProperty link_during_batch;
+    ModelListener<ExperimentalDataModel> data_listener(&data_model);
+    data_listener.setOnItemInserted([&](auto, auto) {
+        if (data_model.isBatchInProgress() && canvas->displayName() != "renamed") {
+            canvas->setDisplayName("renamed");
+            link_during_batch = linkedProperty(scan);
+        }
+    });
+
+    int scan_change_count{0};
+    ModelListener<InstrumentModel> instrument_listener(&instrument_model);
+    instrument_listener.setOnDataChange([&](auto, auto) { ++scan_change_count; });
+
+    std::vector<RealDataStruct> data_structs(3, getRealDataStruct());
+    data_model.addDataToCollection(data_structs, data_model.canvasContainer(), canvas);
+    EXPECT_EQ(link, link_during_batch);
+    EXPECT_EQ(::Utils::CreateProperty(graph), linkedProperty(scan));
+    EXPECT_EQ("renamed/data_name", linkedProperty(scan).text());
+    EXPECT_EQ(1, scan_change_count);
+}
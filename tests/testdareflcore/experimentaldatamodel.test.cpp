@@ -10,11 +10,17 @@
 #include "google_test.h"
 
 #include <darefl/model/experimentaldata_types.h>
+#include <darefl/model/experimentaldatacontroller.h>
 #include <darefl/model/experimentaldataitems.h>
 #include <darefl/model/experimentaldatamodel.h>
+#include <darefl/model/instrumentitems.h>
+#include <darefl/model/instrumentmodel.h>
+#include <darefl/model/modelutils.h>
 
 #include <QSignalSpy>
+#include <mvvm/interfaces/undostackinterface.h>
 #include <mvvm/model/modelutils.h>
+#include <mvvm/signals/modellistener.h>
 #include <mvvm/standarditems/graphitem.h>
 
 using namespace ModelView;
@@ -76,6 +82,169 @@ TEST_F(ExperimentalDataModelTest, addDataToCollection)
     EXPECT_EQ(3, root_container_item->childrenCount());
 }
 
+//! Test the batch version of addDataToCollection method
+TEST_F(ExperimentalDataModelTest, addDataListToCollection)
+{
+    ExperimentalDataModel model;
+    int default_child_count = CanvasItem().childrenCount();
+    auto root_view_item = Utils::TopItem<CanvasContainerItem>(&model);
+    auto root_container_item = Utils::TopItem<ExperimentalDataContainerItem>(&model);
+
+    std::vector<RealDataStruct> data_structs(3, getRealDataStruct());
+    data_structs.push_back(RealDataStruct());
+    auto data_group_item = model.addDataToCollection(data_structs, root_view_item);
+    EXPECT_FALSE(model.isBatchInProgress());
+    EXPECT_EQ(1, root_view_item->childrenCount());
+    EXPECT_EQ(default_child_count + 3, data_group_item->childrenCount());
+    EXPECT_EQ(3, root_container_item->childrenCount());
+
+    // scan linked to one of the existing graphs
+    InstrumentModel instrument_model;
+    ExperimentalDataController controller(&model, &instrument_model);
+    auto scan = instrument_model.insertItem<ExperimentalScanItem>();
+    auto graph = data_group_item->graphItems().front();
+    scan->setGraphItem(graph);
+    const auto link = ::Utils::CreateProperty(graph);
+
+    // notifications the controller processes, i.e. all outside of a batch
+    int processed_count{0};
+    ModelListener<ExperimentalDataModel> listener(&model);
+    auto on_change = [&](auto, auto) {
+        if (!model.isBatchInProgress())
+            ++processed_count;
+    };
+    listener.setOnDataChange(on_change);
+    listener.setOnItemInserted(on_change);
+    listener.setOnAboutToRemoveItem(on_change);
+    listener.setOnItemRemoved(on_change);
+
+    // the refresh of a single graph is what the controller sees of the whole batch
+    model.moveItem(graph, data_group_item, graph->tagRow());
+    const int single_update_count = processed_count;
+    EXPECT_GT(single_update_count, 0);
+    processed_count = 0;
+
+    auto result = model.addDataToCollection(data_structs, root_view_item, data_group_item);
+    EXPECT_EQ(result, data_group_item);
+    EXPECT_EQ(default_child_count + 6, data_group_item->childrenCount());
+    EXPECT_EQ(6, root_container_item->childrenCount());
+    EXPECT_EQ(single_update_count, processed_count);
+    EXPECT_EQ(link, scan->property<ExternalProperty>(ExperimentalScanItem::P_IMPORTED_DATA));
+    EXPECT_EQ(graph, scan->graphItem());
+}
+
+//! Uncertainties of the data are available in full resolution, mismatching ones are dropped
+TEST_F(ExperimentalDataModelTest, addDataWithErrors)
+{
+    ExperimentalDataModel model;
+    auto root_view_item = Utils::TopItem<CanvasContainerItem>(&model);
+
+    auto data_struct = getRealDataStruct();
+    data_struct.data_errors = std::vector<double>(data_struct.data.size(), 0.5);
+    data_struct.axis_resolution = {0.1};
+    auto canvas = model.addDataToCollection(data_struct, root_view_item);
+    auto graph = canvas->graphItems().at(0);
+
+    EXPECT_FALSE(model.isDecimated(graph->dataItem()));
+    EXPECT_EQ(data_struct.axis, model.sourceAxis(graph->dataItem()));
+    EXPECT_EQ(data_struct.data_errors, model.sourceErrors(graph->dataItem()));
+    EXPECT_TRUE(model.sourceResolution(graph->dataItem()).empty());
+
+    canvas = model.addDataToCollection(getRealDataStruct(), root_view_item);
+    EXPECT_TRUE(model.sourceErrors(canvas->graphItems().at(0)->dataItem()).empty());
+}
+
+//! Zoom and pan replace the decimated view of large data without undo commands
+TEST_F(ExperimentalDataModelTest, decimatedView)
+{
+    ExperimentalDataModel model;
+    auto root_view_item = Utils::TopItem<CanvasContainerItem>(&model);
+
+    auto data_struct = getRealDataStruct();
+    const int n_points = 20000;
+    data_struct.axis.resize(n_points);
+    data_struct.data.resize(n_points);
+    for (int i = 0; i < n_points; ++i) {
+        data_struct.axis[i] = i;
+        data_struct.data[i] = 1.0 / (1.0 + i);
+    }
+    auto canvas = model.addDataToCollection(data_struct, root_view_item);
+    auto data = canvas->graphItems().at(0)->dataItem();
+    ASSERT_TRUE(model.isDecimated(data));
+    EXPECT_LT(data->binCenters().size(), n_points);
+    EXPECT_EQ(data_struct.axis, model.sourceAxis(data));
+
+    const int undo_index = model.undoStack()->index();
+    model.updateDataView(data, 100.0, 200.0, 50);
+    auto axis = data->binCenters();
+    ASSERT_FALSE(axis.empty());
+    EXPECT_EQ(axis.size(), data->binValues().size());
+    EXPECT_GE(axis.front(), 99.0);
+    EXPECT_LE(axis.back(), 201.0);
+    EXPECT_EQ(undo_index, model.undoStack()->index());
+}
+
+//! Data items of the opened project aren't taken as the source until its stored data arrives,
+//! which is reported as the change of data items
+TEST_F(ExperimentalDataModelTest, sourcePending)
+{
+    ExperimentalDataModel model;
+    auto root_view_item = Utils::TopItem<CanvasContainerItem>(&model);
+
+    auto data_struct = getRealDataStruct();
+    data_struct.data_errors = std::vector<double>(data_struct.data.size(), 0.5);
+    auto canvas = model.addDataToCollection(data_struct, root_view_item);
+    auto data = canvas->graphItems().at(0)->dataItem();
+    auto entries = model.dataStoreEntries();
+
+    model.beginDataStoreLoad();
+    EXPECT_TRUE(model.isSourcePending(data));
+    EXPECT_TRUE(model.sourceAxis(data).empty());
+    EXPECT_TRUE(model.sourceValues(data).empty());
+    EXPECT_TRUE(model.sourceErrors(data).empty());
+
+    // data imported while loading has its source
+    canvas = model.addDataToCollection(getRealDataStruct(), root_view_item, canvas);
+    auto imported = canvas->graphItems().at(1)->dataItem();
+    EXPECT_FALSE(model.isSourcePending(imported));
+    EXPECT_EQ(data_struct.axis, model.sourceAxis(imported));
+
+    std::vector<SessionItem*> changed;
+    ModelListener<ExperimentalDataModel> listener(&model);
+    listener.setOnDataChange([&changed](auto item, auto) { changed.push_back(item); });
+
+    model.setDataStoreEntries(entries);
+    EXPECT_FALSE(model.isSourcePending(data));
+    EXPECT_EQ(data_struct.axis, model.sourceAxis(data));
+    EXPECT_EQ(data_struct.data_errors, model.sourceErrors(data));
+    EXPECT_EQ(changed, std::vector<SessionItem*>{data});
+}
+
+//! Full-resolution data is removed from the store together with its graph
+TEST_F(ExperimentalDataModelTest, removeDataWithErrors)
+{
+    ExperimentalDataModel model;
+    auto root_view_item = Utils::TopItem<CanvasContainerItem>(&model);
+
+    auto data_struct = getRealDataStruct();
+    data_struct.data_errors = std::vector<double>(data_struct.data.size(), 0.5);
+    auto canvas = model.addDataToCollection(data_struct, root_view_item);
+    model.addDataToCollection(data_struct, root_view_item, canvas);
+    auto graphs = canvas->graphItems();
+    const auto removed_id = graphs.at(0)->dataItem()->identifier();
+    const auto kept_id = graphs.at(1)->dataItem()->identifier();
+    EXPECT_NE(nullptr, model.dataStore()->columns(removed_id));
+
+    model.removeDataFromCollection({graphs.at(0)});
+    EXPECT_EQ(nullptr, model.dataStore()->columns(removed_id));
+    EXPECT_NE(nullptr, model.dataStore()->columns(kept_id));
+    EXPECT_EQ(1, model.dataStoreEntries().size());
+
+    model.removeDataFromCollection({canvas});
+    EXPECT_EQ(nullptr, model.dataStore()->columns(kept_id));
+    EXPECT_TRUE(model.dataStoreEntries().empty());
+}
+
 //! Test the removeAllDataFromCollection method
 TEST_F(ExperimentalDataModelTest, removeAllDataFromCollection)
 {
@@ -0,0 +1,265 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <darefl/model/experimentaldatastore.h>
+#include <cstdint>
+#include <fstream>
+
+//! Tests of ExperimentalDataStore.
+
+class ExperimentalDataStoreTest : public ::testing::Test
+{
+public:
+    ~ExperimentalDataStoreTest();
+};
+
+ExperimentalDataStoreTest::~ExperimentalDataStoreTest() = default;
+
+//! Stored points are sorted along the axis.
+
+TEST_F(ExperimentalDataStoreTest, insert)
+{
+    ExperimentalDataStore store;
+    EXPECT_EQ(store.columns("a"), nullptr);
+
+    store.insert("a", {3.0, 1.0, 2.0}, {30.0, 10.0, 20.0});
+    auto columns = store.columns("a");
+    ASSERT_NE(columns, nullptr);
+    EXPECT_EQ(columns->axis, std::vector<double>({1.0, 2.0, 3.0}));
+    EXPECT_EQ(columns->values, std::vector<double>({10.0, 20.0, 30.0}));
+
+    store.insert("b", {1.0}, {10.0});
+    EXPECT_TRUE(store.remove("b"));
+    EXPECT_FALSE(store.remove("b"));
+    EXPECT_EQ(store.columns("b"), nullptr);
+
+    // columns are kept alive by the reader
+    store.clear();
+    EXPECT_EQ(store.columns("a"), nullptr);
+    EXPECT_EQ(columns->axis.size(), 3u);
+}
+
+//! Uncertainties are sorted together with the points they belong to.
+
+TEST_F(ExperimentalDataStoreTest, insertWithErrors)
+{
+    ExperimentalDataStore store;
+    store.insert("a", {{2.0, 1.0}, {20.0, 10.0}, {2.0, 1.0}, {}});
+    auto columns = store.columns("a");
+    ASSERT_NE(columns, nullptr);
+    EXPECT_EQ(columns->axis, std::vector<double>({1.0, 2.0}));
+    EXPECT_EQ(columns->errors, std::vector<double>({1.0, 2.0}));
+    EXPECT_TRUE(columns->resolution.empty());
+
+    EXPECT_THROW(store.insert("b", {{1.0, 2.0}, {10.0, 20.0}, {1.0}, {}}), std::runtime_error);
+}
+
+//! Only requested keys are saved, loading replaces the content.
+
+TEST_F(ExperimentalDataStoreTest, saveLoad)
+{
+    TestUtils::CreateTestDirectory("experimentaldatastore");
+    const auto file_name = TestUtils::TestFileName("experimentaldatastore", "store.bin");
+
+    ExperimentalDataStore store;
+    store.insert("a", {1.0, 2.0}, {10.0, 20.0});
+    store.insert("b", {1.0}, {10.0});
+    store.insert("e", {{1.0, 2.0}, {10.0, 20.0}, {0.1, 0.2}, {0.01, 0.02}});
+    EXPECT_TRUE(store.save(file_name, {"a", "c", "e"}));
+
+    ExperimentalDataStore loaded;
+    loaded.insert("d", {1.0}, {1.0});
+    EXPECT_TRUE(loaded.load(file_name));
+    EXPECT_EQ(loaded.columns("b"), nullptr);
+    EXPECT_EQ(loaded.columns("d"), nullptr);
+    ASSERT_NE(loaded.columns("a"), nullptr);
+    EXPECT_EQ(loaded.columns("a")->axis, std::vector<double>({1.0, 2.0}));
+    EXPECT_EQ(loaded.columns("a")->values, std::vector<double>({10.0, 20.0}));
+    EXPECT_TRUE(loaded.columns("a")->errors.empty());
+    ASSERT_NE(loaded.columns("e"), nullptr);
+    EXPECT_EQ(loaded.columns("e")->errors, std::vector<double>({0.1, 0.2}));
+    EXPECT_EQ(loaded.columns("e")->resolution, std::vector<double>({0.01, 0.02}));
+
+    // missing file means empty store
+    EXPECT_TRUE(loaded.load(TestUtils::TestFileName("experimentaldatastore", "missing.bin")));
+    EXPECT_EQ(loaded.columns("a"), nullptr);
+}
+
+//! Entries are written and read without the store, with the progress reported.
+
+TEST_F(ExperimentalDataStoreTest, writeRead)
+{
+    TestUtils::CreateTestDirectory("experimentaldatastore");
+    const auto file_name = TestUtils::TestFileName("experimentaldatastore", "entries.bin");
+
+    ExperimentalDataStore store;
+    store.insert("a", {1.0, 2.0}, {10.0, 20.0});
+    store.insert("b", {1.0}, {10.0});
+    auto entries = store.entries({"b", "c", "a"});
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries[0].first, "b");
+    EXPECT_EQ(entries[0].second, store.columns("b"));
+
+    std::vector<int> progress;
+    auto on_progress = [&progress](int value) { progress.push_back(value); };
+    EXPECT_TRUE(ExperimentalDataStore::write(file_name, entries, on_progress));
+    EXPECT_EQ(progress, std::vector<int>({50, 100}));
+
+    ExperimentalDataStore::entries_t loaded;
+    progress.clear();
+    EXPECT_TRUE(ExperimentalDataStore::read(file_name, loaded, on_progress));
+    EXPECT_EQ(progress, std::vector<int>({50, 100}));
+    ASSERT_EQ(loaded.size(), 2u);
+    EXPECT_EQ(loaded[1].first, "a");
+    EXPECT_EQ(loaded[1].second->values, std::vector<double>({10.0, 20.0}));
+
+    ExperimentalDataStore other;
+    other.assign(loaded);
+    EXPECT_EQ(other.columns("b")->axis, std::vector<double>({1.0}));
+}
+
+//! Files written in QDataStream by version 2 are still read.
+
+TEST_F(ExperimentalDataStoreTest, readVersion2)
+{
+    // big-endian header and sizes, key in UTF-16, columns as raw native doubles
+    std::string content;
+    auto append_uint = [&content](uint64_t value, int bytes) {
+        for (int i = bytes - 1; i >= 0; --i)
+            content.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    };
+    auto append_column = [&content, &append_uint](const std::vector<double>& column) {
+        append_uint(column.size(), 8);
+        content.append(reinterpret_cast<const char*>(column.data()),
+                       column.size() * sizeof(double));
+    };
+    append_uint(0x44524653, 4);
+    append_uint(2, 4);
+    append_uint(1, 8);
+    append_uint(2, 4);
+    append_uint('a', 2);
+    append_column({1.0, 2.0});
+    append_column({10.0, 20.0});
+    append_column({0.1, 0.2});
+    append_column({});
+    const auto file_name =
+        TestUtils::WriteTestFile("experimentaldatastore", "version2.bin", content);
+
+    ExperimentalDataStore::entries_t entries;
+    std::vector<int> progress;
+    auto on_progress = [&progress](int value) { progress.push_back(value); };
+    EXPECT_TRUE(ExperimentalDataStore::read(file_name, entries, on_progress));
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].first, "a");
+    EXPECT_EQ(entries[0].second->axis, std::vector<double>({1.0, 2.0}));
+    EXPECT_EQ(entries[0].second->values, std::vector<double>({10.0, 20.0}));
+    EXPECT_EQ(entries[0].second->errors, std::vector<double>({0.1, 0.2}));
+    EXPECT_TRUE(entries[0].second->resolution.empty());
+    EXPECT_EQ(progress, std::vector<int>({100}));
+}
+
+//! Files of version 3, without the byte order mark and with bytewise checksums, are still read.
+
+TEST_F(ExperimentalDataStoreTest, readVersion3)
+{
+    // big-endian header, raw native sizes, keys padded to 8 bytes, FNV-1a checksums of columns
+    std::string content;
+    auto append_native = [&content](uint64_t value) {
+        content.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    auto append_column = [&content, &append_native](const std::vector<double>& column) {
+        auto data = reinterpret_cast<const char*>(column.data());
+        const size_t size = column.size() * sizeof(double);
+        uint64_t checksum = 14695981039346656037ull;
+        for (size_t i = 0; i < size; ++i)
+            checksum = (checksum ^ static_cast<unsigned char>(data[i])) * 1099511628211ull;
+        append_native(column.size());
+        append_native(checksum);
+        content.append(data, size);
+    };
+    content = std::string("DRFS") + std::string("\0\0\0\3", 4);
+    append_native(1);
+    append_native(1);
+    content.append(std::string("a\0\0\0\0\0\0\0", 8));
+    append_column({1.0, 2.0});
+    append_column({10.0, 20.0});
+    append_column({});
+    append_column({0.01, 0.02});
+    const auto file_name =
+        TestUtils::WriteTestFile("experimentaldatastore", "version3.bin", content);
+
+    ExperimentalDataStore::entries_t entries;
+    EXPECT_TRUE(ExperimentalDataStore::read(file_name, entries));
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].first, "a");
+    EXPECT_EQ(entries[0].second->axis, std::vector<double>({1.0, 2.0}));
+    EXPECT_EQ(entries[0].second->values, std::vector<double>({10.0, 20.0}));
+    EXPECT_TRUE(entries[0].second->errors.empty());
+    EXPECT_EQ(entries[0].second->resolution, std::vector<double>({0.01, 0.02}));
+}
+
+//! Files written with another byte order aren't read.
+
+TEST_F(ExperimentalDataStoreTest, foreignByteOrder)
+{
+    TestUtils::CreateTestDirectory("experimentaldatastore");
+    const auto file_name = TestUtils::TestFileName("experimentaldatastore", "byteorder.bin");
+
+    ExperimentalDataStore store;
+    store.insert("a", {1.0, 2.0}, {10.0, 20.0});
+    EXPECT_TRUE(store.save(file_name, {"a"}));
+
+    // reversing the byte order mark following the header
+    std::fstream file(file_name, std::ios::in | std::ios::out | std::ios::binary);
+    char mark[8];
+    file.seekg(8);
+    file.read(mark, sizeof(mark));
+    std::reverse(mark, mark + sizeof(mark));
+    file.seekp(8);
+    file.write(mark, sizeof(mark));
+    file.close();
+
+    ExperimentalDataStore::entries_t entries;
+    EXPECT_FALSE(ExperimentalDataStore::read(file_name, entries));
+    EXPECT_TRUE(entries.empty());
+}
+
+//! Corrupted data is detected by the checksum, nothing is loaded then.
+
+TEST_F(ExperimentalDataStoreTest, corruptedFile)
+{
+    TestUtils::CreateTestDirectory("experimentaldatastore");
+    const auto file_name = TestUtils::TestFileName("experimentaldatastore", "corrupted.bin");
+
+    ExperimentalDataStore store;
+    store.insert("a", {{1.0, 2.0}, {10.0, 20.0}, {0.1, 0.2}, {0.01, 0.02}});
+    EXPECT_TRUE(store.save(file_name, {"a"}));
+
+    // flipping one bit of the last stored value
+    std::fstream file(file_name, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekg(-1, std::ios::end);
+    const char last = static_cast<char>(file.get() ^ 0x01);
+    file.seekp(-1, std::ios::end);
+    file.put(last);
+    file.close();
+
+    ExperimentalDataStore loaded;
+    EXPECT_FALSE(loaded.load(file_name));
+    EXPECT_EQ(loaded.columns("a"), nullptr);
+
+    // no progress is reported for the failed entry
+    ExperimentalDataStore::entries_t entries;
+    std::vector<int> progress;
+    auto on_progress = [&progress](int value) { progress.push_back(value); };
+    EXPECT_FALSE(ExperimentalDataStore::read(file_name, entries, on_progress));
+    EXPECT_TRUE(progress.empty());
+}
@@ -0,0 +1,92 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include <darefl/quicksimeditor/fieldintensity.h>
+#include <darefl/quicksimeditor/materialprofile.h>
+#include <darefl/quicksimeditor/quicksimutils.h>
+#include <minikernel/Computation/Slice.h>
+#include <minikernel/MultiLayer/KzComputation.h>
+#include <minikernel/MultiLayer/SpecularScalarTanhStrategy.h>
+
+//! Tests of FieldIntensity calculations.
+
+class FieldIntensityTest : public ::testing::Test
+{
+public:
+    ~FieldIntensityTest();
+
+    //! Returns ambience, Ti/Ni bilayer and Si substrate.
+    static multislice_t createMultislice()
+    {
+        return {{{0.0, 0.0}, 0.0, 0.0},
+                {{-1.9493e-06, 0.0}, 30.0, 2.0},
+                {{9.4245e-06, 1e-08}, 70.0, 2.0},
+                {{2.0704e-06, 0.0}, 0.0, 2.0}};
+    }
+};
+
+FieldIntensityTest::~FieldIntensityTest() = default;
+
+//! Field intensity in vacuum is equal to one everywhere.
+
+TEST_F(FieldIntensityTest, vacuum)
+{
+    multislice_t multislice = {{{0.0, 0.0}, 0.0, 0.0}};
+    std::vector<double> qvalues = {0.01, 0.1, 0.2};
+    auto zvalues = MaterialProfile::GenerateZValues(100, -50.0, 10.0);
+
+    auto result = FieldIntensity::Calculate(multislice, qvalues, zvalues);
+    ASSERT_EQ(result.size(), qvalues.size() * zvalues.size());
+    for (auto value : result)
+        EXPECT_NEAR(value, 1.0, 1e-10);
+}
+
+//! Field intensity coincides with the one calculated from amplitudes with exact exponents.
+
+TEST_F(FieldIntensityTest, exactExponents)
+{
+    auto multislice = createMultislice();
+    std::vector<double> qvalues = {0.005, 0.02, 0.1, 0.3};
+    auto zvalues = MaterialProfile::GenerateZValues(500, -150.0, 20.0);
+
+    auto result = FieldIntensity::Calculate(multislice, qvalues, zvalues);
+    ASSERT_EQ(result.size(), qvalues.size() * zvalues.size());
+
+    auto slices = ::Utils::createBornAgainSlices(multislice);
+    const std::vector<double> z_top = {0.0, 0.0, -30.0, -100.0};
+    SpecularScalarTanhStrategy strategy;
+    std::vector<Eigen::Vector2cd> t_r;
+    for (size_t iq = 0; iq < qvalues.size(); ++iq) {
+        auto kz = KzComputation::computeKzFromSLDs(slices, -0.5 * qvalues[iq]);
+        strategy.computeAmplitudes(slices, kz, t_r);
+        for (size_t iz = 0; iz < zvalues.size(); ++iz) {
+            size_t i = 0;
+            while (i + 1 < z_top.size() && zvalues[iz] <= z_top[i + 1])
+                ++i;
+            const double z = zvalues[iz] - z_top[i];
+            const auto psi = t_r[i](0) * exp_I(-kz[i] * z) + t_r[i](1) * exp_I(kz[i] * z);
+            const double expected = std::norm(psi);
+            EXPECT_NEAR(result[iq * zvalues.size() + iz], expected, 1e-9 * (1.0 + expected));
+        }
+    }
+}
+
+//! Result doesn't depend on the number of threads.
+
+TEST_F(FieldIntensityTest, threadCount)
+{
+    auto multislice = createMultislice();
+    auto qvalues = MaterialProfile::GenerateZValues(37, 0.001, 0.2);
+    auto zvalues = MaterialProfile::GenerateZValues(100, -150.0, 20.0);
+
+    auto expected = FieldIntensity::Calculate(multislice, qvalues, zvalues, 1);
+    EXPECT_EQ(FieldIntensity::Calculate(multislice, qvalues, zvalues, 4), expected);
+    EXPECT_EQ(FieldIntensity::Calculate(multislice, qvalues, zvalues, 100), expected);
+}
@@ -0,0 +1,163 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include "test_utils.h"
+
+#include <darefl/famousloader/importcache.h>
+#include <darefl/famousloader/importlogic.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <thread>
+
+using namespace DataImportLogic;
+
+//! Test the on-disk cache of parsed files
+class ImportCacheTest : public ::testing::Test
+{
+public:
+    ~ImportCacheTest();
+
+    std::string cacheDirectory() const
+    {
+        return TestUtils::TestFileName("importtestfiles", "importcache");
+    }
+};
+
+ImportCacheTest::~ImportCacheTest() = default;
+
+//! Test that stored entries are loaded back, only for the same source and signature
+TEST_F(ImportCacheTest, storeLoadTest)
+{
+    auto path = TestUtils::WriteTestFile("importtestfiles", "importcache_store.txt", "1,2\n");
+    ImportCache cache(cacheDirectory());
+
+    DataImportUtils::header_map header = {{"q", 0}, {"R", 1}};
+    DataImportUtils::numeric_data data = {{1.0, 2.0, 3.0}, {1e-300, std::nan(""), -0.5}};
+    ASSERT_TRUE(cache.store(path, "filters", header, data));
+
+    DataImportUtils::header_map loaded_header;
+    DataImportUtils::numeric_data loaded_data;
+    ASSERT_TRUE(cache.load(path, "filters", loaded_header, loaded_data));
+    EXPECT_EQ(header, loaded_header);
+    ASSERT_EQ(2, loaded_data.size());
+    EXPECT_EQ(data.at(0), loaded_data.at(0));
+    EXPECT_EQ(1e-300, loaded_data.at(1).at(0));
+    EXPECT_TRUE(std::isnan(loaded_data.at(1).at(1)));
+    EXPECT_EQ(-0.5, loaded_data.at(1).at(2));
+
+    EXPECT_FALSE(cache.load(path, "other filters", loaded_header, loaded_data));
+    EXPECT_FALSE(cache.load(path + ".missing", "filters", loaded_header, loaded_data));
+
+    // a changed source file invalidates the entry
+    TestUtils::WriteTestFile("importtestfiles", "importcache_store.txt", "1,2,3\n");
+    EXPECT_FALSE(cache.load(path, "filters", loaded_header, loaded_data));
+}
+
+//! Test that a damaged entry is not loaded
+TEST_F(ImportCacheTest, damagedEntryTest)
+{
+    auto path = TestUtils::WriteTestFile("importtestfiles", "importcache_damaged.txt", "1\n");
+    ImportCache cache(cacheDirectory());
+    ASSERT_TRUE(cache.store(path, "", {}, {{1.0, 2.0}}));
+
+    std::string content;
+    {
+        std::ifstream entry(cache.entryPath(path), std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(entry), {});
+    }
+    std::ofstream(cache.entryPath(path), std::ios::binary) << content.substr(0, content.size() - 4);
+
+    DataImportUtils::header_map header;
+    DataImportUtils::numeric_data data;
+    EXPECT_FALSE(cache.load(path, "", header, data));
+}
+
+//! Test that the import logic takes the parsed files from the cache
+TEST_F(ImportCacheTest, importLogicTest)
+{
+    auto path =
+        TestUtils::WriteTestFile("importtestfiles", "importcache_logic.txt", "1,10\n2,20\n");
+    ImportLogic import_logic;
+    import_logic.setCacheDirectory(cacheDirectory());
+    import_logic.setFiles({path});
+    auto filter = import_logic.addLineFilter("Data");
+    filter->setActive(true);
+    filter->setStart(0);
+    filter->setEnd(-1);
+    filter->setSeparator("Comma (,)");
+
+    auto output = import_logic.getFinalOutput();
+    EXPECT_EQ(std::vector<double>({1.0, 2.0}), output[path]->axis());
+
+    DataImportUtils::header_map header;
+    DataImportUtils::numeric_data data;
+    ImportCache cache(cacheDirectory());
+    ASSERT_TRUE(cache.load(path, import_logic.filterSignature(), header, data));
+    EXPECT_EQ(std::vector<double>({10.0, 20.0}), data.at(1));
+
+    // the cached columns are used instead of parsing the file again
+    ASSERT_TRUE(cache.store(path, import_logic.filterSignature(), {}, {{5.0}, {50.0}}));
+    output = import_logic.getFinalOutput();
+    EXPECT_EQ(std::vector<double>({5.0}), output[path]->axis());
+
+    // other filters need another parse
+    filter->setEnd(1);
+    output = import_logic.getFinalOutput();
+    EXPECT_EQ(std::vector<double>({1.0}), output[path]->axis());
+}
+
+//! Test that the least recently used entries are removed beyond the size limit
+TEST_F(ImportCacheTest, evictionTest)
+{
+    auto directory = TestUtils::TestFileName("importtestfiles", "importcache_eviction");
+    QDir(QString::fromStdString(directory)).removeRecursively();
+    std::vector<std::string> paths;
+    for (auto name : {"importcache_lru1.txt", "importcache_lru2.txt", "importcache_lru3.txt"})
+        paths.push_back(TestUtils::WriteTestFile("importtestfiles", name, "1\n"));
+    auto has_entry = [](const ImportCache& cache, const std::string& path) {
+        return QFile::exists(QString::fromStdString(cache.entryPath(path)));
+    };
+    // entries are ordered by their modification time
+    auto next_use = []() { std::this_thread::sleep_for(std::chrono::milliseconds(20)); };
+
+    // the limit fits two entries of the same size
+    ImportCache unlimited(directory);
+    ASSERT_TRUE(unlimited.store(paths[0], "", {}, {{1.0}}));
+    auto entry_size = QFileInfo(QString::fromStdString(unlimited.entryPath(paths[0]))).size();
+    ImportCache cache(directory, 2 * entry_size);
+    next_use();
+    ASSERT_TRUE(cache.store(paths[1], "", {}, {{1.0}}));
+    EXPECT_TRUE(has_entry(cache, paths[0]));
+
+    // the first entry is used again, the second one is the least recently used
+    next_use();
+    DataImportUtils::header_map header;
+    DataImportUtils::numeric_data data;
+    ASSERT_TRUE(cache.load(paths[0], "", header, data));
+    next_use();
+    ASSERT_TRUE(cache.store(paths[2], "", {}, {{1.0}}));
+    EXPECT_TRUE(has_entry(cache, paths[0]));
+    EXPECT_FALSE(has_entry(cache, paths[1]));
+    EXPECT_TRUE(has_entry(cache, paths[2]));
+
+    // the stored entry is kept even if it doesn't fit
+    ImportCache tiny(directory, 0);
+    next_use();
+    ASSERT_TRUE(tiny.store(paths[1], "", {}, {{1.0}}));
+    EXPECT_FALSE(has_entry(tiny, paths[0]));
+    EXPECT_TRUE(has_entry(tiny, paths[1]));
+    EXPECT_FALSE(has_entry(tiny, paths[2]));
+}
@@ -0,0 +1,111 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include "test_utils.h"
+
+#include <darefl/famousloader/importfile.h>
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace DataImportLogic;
+
+//! Test the memory mapped import file
+class ImportFileTest : public ::testing::Test
+{
+public:
+    ~ImportFileTest();
+};
+
+ImportFileTest::~ImportFileTest() = default;
+
+//! Test that the lines coincide with the ones read by getline
+TEST_F(ImportFileTest, linesTest)
+{
+    std::string content = "Header_0,Header_1\n";
+    for (int i = 0; i < 100; ++i)
+        content += std::to_string(i) + "," + std::to_string(i * 1e-3) + "\n";
+    auto path = TestUtils::WriteTestFile("importtestfiles", "importfile_lines.txt", content);
+    ImportFile file(path);
+
+    std::vector<std::string> expected;
+    std::ifstream stream(path);
+    for (std::string line; getline(stream, line);)
+        expected.push_back(line);
+
+    EXPECT_EQ(path, file.path());
+    ASSERT_EQ(expected.size(), file.lineCount());
+    ASSERT_EQ(expected.size(), file.file().size());
+    for (int i = 0; i < file.lineCount(); ++i)
+        EXPECT_EQ(expected.at(i), file.line(i));
+
+    auto thumbnail = file.thumbnail();
+    ASSERT_EQ(40, thumbnail.size());
+    for (int i = 0; i < thumbnail.size(); ++i)
+        EXPECT_EQ(expected.at(i), thumbnail.at(i));
+}
+
+//! Test the line ends, empty lines and the last line without line end
+TEST_F(ImportFileTest, lineEndsTest)
+{
+    auto path = TestUtils::WriteTestFile("importtestfiles", "importfile_ends.txt",
+                                         "a b\r\n\nc d\r\n\r\ne f");
+    ImportFile file(path);
+
+    std::vector<std::string_view> expected{"a b", "", "c d", "", "e f"};
+    EXPECT_EQ(expected, file.file());
+    EXPECT_EQ(expected, file.thumbnail());
+    EXPECT_THROW(file.line(5), std::out_of_range);
+}
+
+//! Test empty and missing files
+TEST_F(ImportFileTest, emptyFileTest)
+{
+    ImportFile empty_file(TestUtils::WriteTestFile("importtestfiles", "importfile_empty.txt", ""));
+    EXPECT_EQ(0, empty_file.lineCount());
+    EXPECT_TRUE(empty_file.thumbnail().empty());
+
+    ImportFile missing_file(TestUtils::TestFileName("importtestfiles", "importfile_missing.txt"));
+    EXPECT_EQ(0, missing_file.lineCount());
+}
+
+//! Test that the chunks cover all lines in order
+TEST_F(ImportFileTest, readChunksTest)
+{
+    std::string content;
+    for (int i = 0; i < 25; ++i)
+        content += "line " + std::to_string(i) + "\r\n";
+    ImportFile file(TestUtils::WriteTestFile("importtestfiles", "importfile_chunks.txt", content));
+
+    std::vector<int> first_lines;
+    std::vector<std::string_view> lines;
+    file.readChunks(10, [&](int first_line, const std::vector<std::string_view>& chunk) {
+        first_lines.push_back(first_line);
+        lines.insert(lines.end(), chunk.begin(), chunk.end());
+        return true;
+    });
+    EXPECT_EQ(std::vector<int>({0, 10, 20}), first_lines);
+    EXPECT_EQ(file.file(), lines);
+
+    // stop after the first chunk
+    first_lines.clear();
+    file.readChunks(10, [&](int first_line, const std::vector<std::string_view>&) {
+        first_lines.push_back(first_line);
+        return false;
+    });
+    EXPECT_EQ(std::vector<int>({0}), first_lines);
+
+    // chunks without lines would never finish the file
+    auto callback = [](int, const std::vector<std::string_view>&) { return true; };
+    EXPECT_THROW(file.readChunks(0, callback), std::runtime_error);
+    EXPECT_THROW(file.readChunks(-1, callback), std::runtime_error);
+}
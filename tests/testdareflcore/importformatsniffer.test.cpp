@@ -0,0 +1,132 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include "test_utils.h"
+
+#include <darefl/famousloader/importfile.h>
+#include <darefl/famousloader/importformatsniffer.h>
+#include <darefl/famousloader/importlogic.h>
+
+#include <string>
+#include <vector>
+
+using namespace DataImportLogic;
+
+//! Test the detection of the file format
+class FormatSnifferTest : public ::testing::Test
+{
+public:
+    ~FormatSnifferTest();
+
+    //! Data lines with the given separator
+    std::string dataLines(int count, const std::string& separator)
+    {
+        std::string output;
+        for (int i = 0; i < count; ++i)
+            output += std::to_string(i * 1e-3) + separator + std::to_string(1.0 / (i + 1))
+                      + separator + std::to_string(-1e-5 * i) + "\n";
+        return output;
+    }
+};
+
+FormatSnifferTest::~FormatSnifferTest() = default;
+
+//! Test the sampling of lines in the middle and at the end of the file
+TEST_F(FormatSnifferTest, sampleLinesTest)
+{
+    auto path = TestUtils::WriteTestFile("importtestfiles", "sniffer_sample.txt", "a\n\nb\r\nc\nd");
+    ImportFile file(path);
+
+    EXPECT_EQ(std::vector<std::string_view>({"a", ""}), file.sampleLines(0.0, 2));
+    EXPECT_EQ(std::vector<std::string_view>({"b", "c", "d"}), file.sampleLines(0.35, 10));
+    EXPECT_TRUE(file.sampleLines(1.0, 10).empty());
+    EXPECT_EQ(std::vector<std::string_view>({"c", "d"}), file.lastLines(2));
+    EXPECT_EQ(std::vector<std::string_view>({"", "b", "c", "d"}), file.lastLines(4));
+    EXPECT_EQ(file.file(), file.lastLines(10));
+
+    ImportFile terminated(
+        TestUtils::WriteTestFile("importtestfiles", "sniffer_terminated.txt", "a\nb\n"));
+    EXPECT_EQ(std::vector<std::string_view>({"b"}), terminated.lastLines(1));
+    EXPECT_TRUE(terminated.lastLines(0).empty());
+}
+
+//! Test a comma separated file with comments, a header and a footer
+TEST_F(FormatSnifferTest, commaSeparatedTest)
+{
+    std::string content = "# instrument: test\n# sample: Ni/Ti\n\nq,R,dR\n";
+    content += dataLines(1000, ",");
+    content += "# end of file\n\n";
+    ImportFile file(TestUtils::WriteTestFile("importtestfiles", "sniffer_comma.txt", content));
+
+    auto format = sniffFormat(file);
+    EXPECT_TRUE(format.valid);
+    EXPECT_EQ(',', format.separator);
+    EXPECT_EQ(3, format.column_count);
+    EXPECT_EQ("#", format.comment_prefix);
+    EXPECT_EQ(3, format.header_line);
+    EXPECT_EQ("", format.header_prefix);
+    EXPECT_EQ(4, format.data_start);
+    EXPECT_EQ(1004, format.data_end);
+}
+
+//! Test a blank separated file with a commented header
+TEST_F(FormatSnifferTest, commentedHeaderTest)
+{
+    std::string content = "% reflectivity\n%  q   R   dR\n";
+    content += dataLines(50, "   ");
+    ImportFile file(TestUtils::WriteTestFile("importtestfiles", "sniffer_blank.txt", content));
+
+    auto format = sniffFormat(file);
+    EXPECT_TRUE(format.valid);
+    EXPECT_EQ(' ', format.separator);
+    EXPECT_EQ(3, format.column_count);
+    EXPECT_EQ("%", format.comment_prefix);
+    EXPECT_EQ(1, format.header_line);
+    EXPECT_EQ("%", format.header_prefix);
+    EXPECT_EQ(2, format.data_start);
+    EXPECT_EQ(-1, format.data_end);
+}
+
+//! Test files without header or without any numbers
+TEST_F(FormatSnifferTest, noHeaderTest)
+{
+    ImportFile data_file(
+        TestUtils::WriteTestFile("importtestfiles", "sniffer_tab.txt", dataLines(10, "\t")));
+    auto format = sniffFormat(data_file);
+    EXPECT_TRUE(format.valid);
+    EXPECT_EQ('\t', format.separator);
+    EXPECT_EQ(-1, format.header_line);
+    EXPECT_EQ(0, format.data_start);
+    EXPECT_EQ(-1, format.data_end);
+
+    ImportFile text_file(TestUtils::WriteTestFile("importtestfiles", "sniffer_text.txt",
+                                                  "no numbers\nin this file\n"));
+    EXPECT_FALSE(sniffFormat(text_file).valid);
+}
+
+//! Test that the detected format sets up the filters of the import logic
+TEST_F(FormatSnifferTest, importLogicTest)
+{
+    std::string content = "# comment\n#q;R;dR\n" + dataLines(20, ";") + "end\n";
+    ImportLogic import_logic;
+    import_logic.setFiles(
+        {TestUtils::WriteTestFile("importtestfiles", "sniffer_logic.txt", content)});
+
+    auto format = import_logic.detectFormat(0);
+    ASSERT_TRUE(format.valid);
+
+    auto header = import_logic.getHeader(0);
+    EXPECT_EQ(DataImportUtils::header_map({{"q", 0}, {"R", 1}, {"dR", 2}}), header);
+    auto data = import_logic.getNumericData(0);
+    ASSERT_EQ(3, data.size());
+    ASSERT_EQ(20, data.at(0).size());
+    EXPECT_DOUBLE_EQ(0.019, data.at(0).back());
+    EXPECT_DOUBLE_EQ(1.0, data.at(1).front());
+}
@@ -0,0 +1,80 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include <darefl/famousloader/importignorematcher.h>
+#include <darefl/famousloader/importutils.h>
+
+#include <string>
+#include <vector>
+
+using namespace DataImportLogic;
+
+//! Test the single pass removal of the ignore strings
+class IgnoreMatcherTest : public ::testing::Test
+{
+public:
+    ~IgnoreMatcherTest();
+};
+
+IgnoreMatcherTest::~IgnoreMatcherTest() = default;
+
+//! Test that nothing is removed or copied without ignore strings
+TEST_F(IgnoreMatcherTest, emptyTest)
+{
+    IgnoreMatcher::Buffer buffer;
+    IgnoreMatcher matcher({"", ""});
+    EXPECT_TRUE(matcher.empty());
+
+    std::string line = "1.0 2.0 # comment";
+    auto result = matcher.strip(line, buffer);
+    EXPECT_EQ(line, result);
+    EXPECT_EQ(line.data(), result.data());
+
+    IgnoreMatcher other({"%"});
+    EXPECT_FALSE(other.empty());
+    EXPECT_EQ(line.data(), other.strip(line, buffer).data());
+}
+
+//! Test that the result coincides with erasing the strings one by one
+TEST_F(IgnoreMatcherTest, eraseSubStringsTest)
+{
+    const std::vector<std::vector<std::string>> ignore_sets = {
+        {"a"}, {"is", "a"}, {"#", "%"}, {"and", "his"}, {"ab", "abc", "b"}};
+    const std::vector<std::string> lines = {"This is a test a",   "",
+                                            "1.0 # 2.0 % 3.0",    "ushers and his shell",
+                                            "abcabxb ab abc cab", "no match here ...."};
+
+    IgnoreMatcher::Buffer buffer;
+    for (const auto& ignore_strings : ignore_sets) {
+        IgnoreMatcher matcher(ignore_strings);
+        for (const auto& line : lines) {
+            auto expected = line;
+            DataImportUtils::eraseSubStrings(expected, ignore_strings);
+            EXPECT_EQ(expected, matcher.strip(line, buffer));
+        }
+    }
+}
+
+//! Test that occurrences formed by the removal are removed as well
+TEST_F(IgnoreMatcherTest, nestedTest)
+{
+    IgnoreMatcher::Buffer buffer;
+    IgnoreMatcher matcher({"ab"});
+    EXPECT_EQ("", matcher.strip("aabb", buffer));
+    EXPECT_EQ("xy", matcher.strip("xaaabbbaby", buffer));
+}
+
+//! Test that of ignore strings ending at the same character the longest one is removed
+TEST_F(IgnoreMatcherTest, overlappingTest)
+{
+    IgnoreMatcher::Buffer buffer;
+    IgnoreMatcher matcher({"he", "she", "his", "hers"});
+    EXPECT_EQ("urs and  ll", matcher.strip("ushers and his shell", buffer));
+}
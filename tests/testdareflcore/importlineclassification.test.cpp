@@ -0,0 +1,145 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include <darefl/famousloader/importlineclassification.h>
+#include <darefl/famousloader/importlinefilter.h>
+#include <darefl/famousloader/importlogic.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace DataImportLogic;
+
+//! Test the compiled line classification
+class LineClassificationTest : public ::testing::Test
+{
+public:
+    ~LineClassificationTest();
+    std::map<std::string, char> m_separators{{"Space ( )", ' '}, {"Comma (,)", ','}, {"Tab", '\t'}};
+};
+
+LineClassificationTest::~LineClassificationTest() = default;
+
+//! Test the classification without any active filter
+TEST_F(LineClassificationTest, defaultTest)
+{
+    LineFilter line_filter("default_name");
+    LineClassification classification({&line_filter});
+
+    EXPECT_EQ(1, classification.segmentCount());
+    for (int line : {0, 1, 1000}) {
+        auto entry = classification.entry(line);
+        EXPECT_EQ(LineType::Comments, entry.type);
+        EXPECT_EQ('!', entry.separator);
+        EXPECT_TRUE(classification.ignoreSet(entry.ignore_set).empty());
+        EXPECT_EQ("black", classification.color(entry.color));
+    }
+}
+
+//! Test that the table agrees with the schemes of the filters applied line by line
+TEST_F(LineClassificationTest, overlappingFiltersTest)
+{
+    LineFilter filter_0("header");
+    filter_0.setSeparators(&m_separators);
+    filter_0.setActive(true);
+    filter_0.setType("Header");
+    filter_0.setSeparator("Comma (,)");
+    filter_0.setColor("red");
+    filter_0.setStart(2);
+    filter_0.setEnd(3);
+
+    LineFilter filter_1("data");
+    filter_1.setSeparators(&m_separators);
+    filter_1.setActive(true);
+    filter_1.setType("Data");
+    filter_1.setSeparator("Tab");
+    filter_1.setColor("blue");
+    filter_1.setIgnoreString("#,%");
+    filter_1.setStart(3);
+    filter_1.setEnd(-1);
+
+    LineFilter filter_2("info");
+    filter_2.setSeparators(&m_separators);
+    filter_2.setActive(true);
+    filter_2.setType("Info");
+    filter_2.setSeparator("Space ( )");
+    filter_2.setColor("green");
+    filter_2.setStart(10);
+    filter_2.setEnd(12);
+
+    LineFilter filter_3("inactive");
+    filter_3.setSeparators(&m_separators);
+    filter_3.setType("Units");
+    filter_3.setStart(0);
+    filter_3.setEnd(-1);
+
+    std::vector<LineFilter*> filters = {&filter_0, &filter_1, &filter_2, &filter_3};
+    LineClassification classification(filters);
+
+    const int length = 30;
+    std::vector<std::string> colors(length, "black");
+    std::vector<char> separators(length, '!');
+    std::vector<std::string> types(length, "Comments");
+    std::vector<std::vector<std::string>> ignores(length);
+    for (auto filter : filters) {
+        filter->processColors(colors);
+        filter->processSeparator(separators);
+        filter->processType(types);
+        filter->processIgnore(ignores);
+    }
+
+    for (int i = 0; i < length; ++i) {
+        auto entry = classification.entry(i);
+        EXPECT_EQ(lineType(types.at(i)), entry.type);
+        EXPECT_EQ(separators.at(i), entry.separator);
+        EXPECT_EQ(ignores.at(i), classification.ignoreSet(entry.ignore_set));
+        EXPECT_EQ(colors.at(i), classification.color(entry.color));
+    }
+    EXPECT_EQ(5, classification.segmentCount());
+}
+
+//! Test that the import logic compiles the filters again only once they changed
+TEST_F(LineClassificationTest, invalidationTest)
+{
+    ImportLogic import_logic;
+    auto filter_0 = import_logic.addLineFilter("data");
+    filter_0->setActive(true);
+    filter_0->setStart(0);
+    filter_0->setEnd(-1);
+
+    auto classification = import_logic.lineClassification();
+    EXPECT_EQ(classification, import_logic.lineClassification());
+    EXPECT_EQ(LineType::Data, classification->entry(5).type);
+
+    filter_0->setType("Comments");
+    auto changed = import_logic.lineClassification();
+    EXPECT_NE(classification, changed);
+    EXPECT_EQ(LineType::Comments, changed->entry(5).type);
+
+    auto filter_1 = import_logic.addLineFilter("header");
+    filter_1->setType("Header");
+    filter_1->setActive(true);
+    auto added = import_logic.lineClassification();
+    EXPECT_NE(changed, added);
+    EXPECT_EQ(LineType::Header, added->entry(0).type);
+
+    import_logic.setLineFilterOrder({filter_1, filter_0});
+    auto reordered = import_logic.lineClassification();
+    EXPECT_NE(added, reordered);
+    EXPECT_EQ(LineType::Comments, reordered->entry(0).type);
+
+    import_logic.removeLineFilter(filter_0);
+    auto removed = import_logic.lineClassification();
+    EXPECT_NE(reordered, removed);
+    EXPECT_EQ(LineType::Header, removed->entry(0).type);
+    EXPECT_EQ(LineType::Comments, removed->entry(1).type);
+}
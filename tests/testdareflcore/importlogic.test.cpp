@@ -259,3 +259,101 @@ TEST_F(ImportLogicTest, totalFiltersResultTest)
         }
     }
 }
+
+//! Test that the converted columns coincide with the string data
+TEST_F(ImportLogicTest, numericDataTest)
+{
+    auto filter_1 = import_logic.addLineFilter("Data");
+
+    filter_1->setType("Data");
+    filter_1->setActive(true);
+    filter_1->setStart(1);
+    filter_1->setEnd(-1);
+
+    for (const auto& separator : separators) {
+        auto file_inputs = generateFiles(separator.second);
+        import_logic.setFiles(getPaths(file_inputs));
+        filter_1->setSeparator(separator.first);
+
+        for (int i = 0; i < file_inputs.size(); ++i) {
+            auto columns = DataImportUtils::transpose(file_inputs[i].data);
+            auto numeric_data = import_logic.getNumericData(i);
+            ASSERT_EQ(columns.size(), numeric_data.size());
+            for (int j = 0; j < columns.size(); ++j)
+                EXPECT_EQ(stringToDouble(columns.at(j)), numeric_data.at(j));
+        }
+        CreateTestFiles::removeFiles(file_inputs);
+    }
+}
+
+//! Test the progress reporting and the cancellation of the final output
+TEST_F(ImportLogicTest, finalOutputProgressTest)
+{
+    auto filter_1 = import_logic.addLineFilter("Data");
+    filter_1->setType("Data");
+    filter_1->setActive(true);
+    filter_1->setStart(1);
+    filter_1->setEnd(-1);
+    filter_1->setSeparator("Comma (,)");
+
+    auto file_inputs = generateFiles(',');
+    import_logic.setFiles(getPaths(file_inputs));
+
+    std::vector<int> reported;
+    auto output = import_logic.getFinalOutput([&reported](int processed_files) {
+        reported.push_back(processed_files);
+        return false;
+    });
+    EXPECT_EQ(file_inputs.size(), output.keys().size());
+    ASSERT_FALSE(reported.empty());
+    EXPECT_EQ(file_inputs.size(), reported.back());
+    EXPECT_TRUE(std::is_sorted(reported.begin(), reported.end()));
+
+    // every file ends up under its own path
+    for (int i = 0; i < file_inputs.size(); ++i) {
+        auto columns = DataImportUtils::transpose(file_inputs[i].data);
+        EXPECT_EQ(stringToDouble(columns.at(0)), output[file_inputs[i].path]->axis());
+    }
+
+    output = import_logic.getFinalOutput([](int) { return true; });
+    EXPECT_TRUE(output.keys().empty());
+
+    CreateTestFiles::removeFiles(file_inputs);
+}
+
+//! Test the filters spanning over several chunks of the streamed file
+TEST_F(ImportLogicTest, streamingChunksTest)
+{
+    const int row_count = 150000;
+    auto file_input = CreateTestFiles::writeDataFile("streaming_chunks.txt", ',', 2, row_count);
+    import_logic.setFiles({file_input.path});
+
+    auto filter_0 = import_logic.addLineFilter("Header");
+    filter_0->setType("Header");
+    filter_0->setActive(true);
+    filter_0->setSeparator("Comma (,)");
+
+    auto filter_1 = import_logic.addLineFilter("Data");
+    filter_1->setType("Data");
+    filter_1->setActive(true);
+    filter_1->setStart(1);
+    filter_1->setEnd(-1);
+    filter_1->setSeparator("Comma (,)");
+
+    auto columns = DataImportUtils::transpose(file_input.data);
+    auto numeric_data = import_logic.getNumericData(0);
+    ASSERT_EQ(2, numeric_data.size());
+    EXPECT_EQ(stringToDouble(columns.at(0)), numeric_data.at(0));
+    EXPECT_EQ(stringToDouble(columns.at(1)), numeric_data.at(1));
+    EXPECT_EQ(file_input.header, import_logic.getHeader(0));
+
+    // data range crossing the chunk boundary
+    filter_1->setStart(65530);
+    filter_1->setEnd(65540);
+    numeric_data = import_logic.getNumericData(0);
+    ASSERT_EQ(2, numeric_data.size());
+    std::vector<std::string> expected(columns.at(0).begin() + 65529, columns.at(0).begin() + 65539);
+    EXPECT_EQ(stringToDouble(expected), numeric_data.at(0));
+
+    CreateTestFiles::removeFile(file_input);
+}
@@ -0,0 +1,199 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include "test_utils.h"
+
+#include <darefl/famousloader/importdatacolumn.h>
+#include <darefl/famousloader/importdatastructure.h>
+#include <darefl/famousloader/importlogic.h>
+#include <darefl/famousloader/importnexusreader.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef DAREFL_HAS_HDF5
+#include <hdf5.h>
+#endif
+
+using namespace DataImportLogic;
+
+//! Test the reader of NeXus/HDF5 reflectometry files
+class NexusReaderTest : public ::testing::Test
+{
+public:
+    ~NexusReaderTest();
+
+    std::string testPath(const std::string& name)
+    {
+        TestUtils::CreateTestDirectory("importtestfiles");
+        return TestUtils::TestFileName("importtestfiles", name);
+    }
+
+#ifdef DAREFL_HAS_HDF5
+    //! Write a dataset of doubles, stored as float32 if requested, with an optional unit
+    static void writeDataset(hid_t group, const std::string& name,
+                             const std::vector<double>& values, const std::string& unit = "",
+                             bool single_precision = false)
+    {
+        hsize_t size = values.size();
+        hid_t space = H5Screate_simple(1, &size, nullptr);
+        hid_t type = single_precision ? H5T_IEEE_F32LE : H5T_IEEE_F64LE;
+        hid_t dataset = H5Dcreate2(group, name.c_str(), type, space, H5P_DEFAULT, H5P_DEFAULT,
+                                   H5P_DEFAULT);
+        H5Dwrite(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data());
+        if (!unit.empty()) {
+            hid_t string_type = H5Tcopy(H5T_C_S1);
+            H5Tset_size(string_type, unit.size());
+            hid_t scalar = H5Screate(H5S_SCALAR);
+            hid_t attribute = H5Acreate2(dataset, "units", string_type, scalar, H5P_DEFAULT,
+                                         H5P_DEFAULT);
+            H5Awrite(attribute, string_type, unit.c_str());
+            H5Aclose(attribute);
+            H5Sclose(scalar);
+            H5Tclose(string_type);
+        }
+        H5Dclose(dataset);
+        H5Sclose(space);
+    }
+
+    //! Write a NeXus like file with a curve in /entry1/data
+    std::string writeNexusFile(const std::string& name, size_t size)
+    {
+        auto path = testPath(name);
+        std::vector<double> q, r, dr, dq;
+        for (size_t i = 0; i < size; ++i) {
+            q.push_back(0.001 * (i + 1));
+            r.push_back(1.0 / (1.0 + i));
+            dr.push_back(0.01 / (1.0 + i));
+            dq.push_back(1e-5 * (i + 1));
+        }
+        hid_t file = H5Fcreate(path.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+        hid_t entry = H5Gcreate2(file, "entry1", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        hid_t instrument = H5Gcreate2(entry, "instrument", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        writeDataset(instrument, "wavelength", {4.0});
+        hid_t data = H5Gcreate2(entry, "data", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        writeDataset(data, "Qz", q, "1/angstrom");
+        writeDataset(data, "R", r, "", true);
+        writeDataset(data, "dR", dr);
+        writeDataset(data, "dQ", dq, "1/angstrom");
+        H5Gclose(data);
+        H5Gclose(instrument);
+        H5Gclose(entry);
+        H5Fclose(file);
+        return path;
+    }
+#endif
+};
+
+NexusReaderTest::~NexusReaderTest() = default;
+
+//! Test the recognition of HDF5 files by their signature
+TEST_F(NexusReaderTest, isNexusFileTest)
+{
+    auto text_path = testPath("nexus_text.txt");
+    std::ofstream(text_path) << "1 2 3\n";
+    EXPECT_FALSE(NexusReader::isNexusFile(text_path));
+    EXPECT_FALSE(NexusReader::isNexusFile(testPath("nexus_missing.h5")));
+    if (!NexusReader::isAvailable()) {
+        EXPECT_THROW(NexusReader reader(text_path), std::runtime_error);
+    }
+}
+
+#ifdef DAREFL_HAS_HDF5
+
+//! Test reading a curve, in full and in parts
+TEST_F(NexusReaderTest, readTest)
+{
+    auto path = writeNexusFile("nexus_read.nxs", 1000);
+    EXPECT_TRUE(NexusReader::isNexusFile(path));
+
+    NexusReader reader(path);
+    EXPECT_EQ(std::vector<std::string>({"/entry1/data"}), reader.curves());
+    EXPECT_EQ(1000, reader.pointCount("/entry1/data"));
+    EXPECT_EQ("1/angstrom", reader.unit("/entry1/data", NexusReader::Q));
+    EXPECT_EQ("", reader.unit("/entry1/data", NexusReader::R));
+
+    auto data = reader.read("/entry1/data");
+    ASSERT_EQ(4, data.size());
+    for (const auto& column : data)
+        EXPECT_EQ(1000, column.size());
+    EXPECT_DOUBLE_EQ(0.001, data[NexusReader::Q].front());
+    EXPECT_DOUBLE_EQ(1.0, data[NexusReader::Q].back());
+    EXPECT_FLOAT_EQ(1.0 / 1000, data[NexusReader::R].back());
+    EXPECT_DOUBLE_EQ(1e-5, data[NexusReader::DQ].front());
+
+    // hyperslab of the datasets, clipped to their size
+    auto part = reader.read("/entry1/data", 500, 10);
+    ASSERT_EQ(10, part[NexusReader::Q].size());
+    EXPECT_DOUBLE_EQ(0.501, part[NexusReader::Q].front());
+    EXPECT_EQ(std::vector<double>(data[NexusReader::DR].begin() + 500,
+                                  data[NexusReader::DR].begin() + 510),
+              part[NexusReader::DR]);
+    EXPECT_EQ(5, reader.read("/entry1/data", 995, 10)[NexusReader::R].size());
+    EXPECT_TRUE(reader.read("/entry1/data", 2000)[NexusReader::R].empty());
+
+    EXPECT_THROW(reader.read("/entry1/instrument"), std::runtime_error);
+}
+
+//! Test the data structure and the import output of a NeXus file
+TEST_F(NexusReaderTest, importLogicTest)
+{
+    auto path = writeNexusFile("nexus_logic.nxs", 20);
+
+    DataStructure data_structure;
+    NexusReader(path).fillDataStructure(data_structure);
+    EXPECT_EQ(4, data_structure.columnCount());
+    EXPECT_EQ("Axis", data_structure.column("Q")->type());
+    EXPECT_EQ("1/angstrom", data_structure.column("Q")->unit());
+    EXPECT_EQ("Intensity", data_structure.column("R")->type());
+    EXPECT_EQ("Intensity error", data_structure.column("dR")->type());
+    EXPECT_EQ("Axis resolution", data_structure.column("dQ")->type());
+
+    ImportLogic import_logic;
+    import_logic.setFiles({path});
+    auto output = import_logic.getFinalOutput();
+    ASSERT_EQ(1, output.keys().size());
+    EXPECT_EQ(20, output[path]->axis().size());
+    EXPECT_EQ("Q", output[path]->axisName());
+    ASSERT_EQ(1, output[path]->dataCount());
+    EXPECT_EQ("R", output[path]->dataName(0));
+    EXPECT_FLOAT_EQ(0.05, output[path]->data(0).back());
+    ASSERT_EQ(20, output[path]->dataErrors(0).size());
+    EXPECT_FLOAT_EQ(0.0005, output[path]->dataErrors(0).back());
+    ASSERT_EQ(20, output[path]->axisResolution().size());
+    EXPECT_FLOAT_EQ(2e-4, output[path]->axisResolution().back());
+    EXPECT_TRUE(output[path]->dataErrors(1).empty());
+}
+
+//! Test that a HDF5 file without reflectivity curve is reported instead of aborting the import
+TEST_F(NexusReaderTest, unreadableFileTest)
+{
+    auto good_path = writeNexusFile("nexus_good.nxs", 20);
+    auto bad_path = testPath("nexus_bad.nxs");
+    hid_t file = H5Fcreate(bad_path.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    hid_t entry = H5Gcreate2(file, "entry1", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    writeDataset(entry, "wavelength", {4.0});
+    H5Gclose(entry);
+    H5Fclose(file);
+
+    ImportLogic import_logic;
+    import_logic.setFiles({good_path, bad_path});
+    EXPECT_TRUE(import_logic.unreadableFiles().empty());
+    import_logic.updateData(1);
+    EXPECT_EQ(0, import_logic.dataStructure()->columnCount());
+
+    ImportOutput output;
+    EXPECT_NO_THROW(output = import_logic.getFinalOutput());
+    EXPECT_EQ(std::vector<std::string>({good_path}), output.keys());
+    EXPECT_EQ(std::vector<std::string>({bad_path}), import_logic.unreadableFiles());
+}
+
+#endif
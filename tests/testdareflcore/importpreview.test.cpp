@@ -0,0 +1,124 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include "test_utils.h"
+
+#include <darefl/famousloader/importlogic.h>
+#include <darefl/famousloader/importpreview.h>
+
+#include <string>
+
+using namespace DataImportLogic;
+
+//! Test the preview formatted on demand
+class ImportPreviewTest : public ::testing::Test
+{
+public:
+    ~ImportPreviewTest();
+
+    //! Write a file with a header and the given number of data lines, return the path
+    std::string writeFile(const std::string& name, int line_count)
+    {
+        std::string content = "a,b\n";
+        for (int i = 0; i < line_count; ++i)
+            content += std::to_string(i) + "," + std::to_string(2 * i) + "\n";
+        return TestUtils::WriteTestFile("importtestfiles", name, content);
+    }
+};
+
+ImportPreviewTest::~ImportPreviewTest() = default;
+
+//! Test that the lines of the preview coincide with the full preview of the thumbnail
+TEST_F(ImportPreviewTest, thumbnailTest)
+{
+    ImportLogic import_logic;
+    import_logic.setFiles({writeFile("importpreview_thumbnail.txt", 100)});
+    auto filter = import_logic.addLineFilter("Data");
+    filter->setActive(true);
+    filter->setStart(1);
+    filter->setEnd(-1);
+    filter->setSeparator("Comma (,)");
+    filter->setColor("blue");
+
+    ImportPreview preview(&import_logic);
+    EXPECT_EQ(0, preview.lineCount());
+    EXPECT_EQ("", preview.html(0, 10));
+
+    preview.setFile(0);
+    EXPECT_EQ(101, preview.lineCount());
+    EXPECT_EQ(import_logic.getPreview(0), preview.html(0, 40));
+    EXPECT_EQ(40, preview.cachedLineCount());
+    EXPECT_EQ("<div><font color=\"black\">a,b</font></div>", preview.line(0));
+    EXPECT_EQ("<div><font color=\"blue\">5<span style=\"background-color:blue\">,</span>10</font>"
+              "</div>",
+              preview.line(6));
+
+    // only the visible range is formatted
+    EXPECT_EQ(preview.line(100), preview.html(100, 50));
+    EXPECT_EQ(41, preview.cachedLineCount());
+}
+
+//! Test that only lines with a changed format are formatted again
+TEST_F(ImportPreviewTest, changedFilterTest)
+{
+    ImportLogic import_logic;
+    import_logic.setFiles({writeFile("importpreview_changed.txt", 20)});
+    auto filter = import_logic.addLineFilter("Data");
+    filter->setActive(true);
+    filter->setStart(1);
+    filter->setEnd(10);
+    filter->setSeparator("Comma (,)");
+
+    ImportPreview preview(&import_logic);
+    preview.setFile(0);
+    const auto* header = &preview.line(0);
+    const auto* inside = &preview.line(5);
+    const auto* outside = &preview.line(15);
+
+    filter->setColor("red");
+    EXPECT_EQ(header, &preview.line(0));
+    EXPECT_EQ(outside, &preview.line(15));
+    EXPECT_NE(std::string::npos, preview.line(5).find("red"));
+    EXPECT_EQ(inside, &preview.line(5));
+
+    filter->setEnd(-1);
+    EXPECT_NE(std::string::npos, preview.line(15).find("red"));
+
+    // setting the same file keeps the cache, another file discards it
+    preview.setFile(0);
+    EXPECT_EQ(3, preview.cachedLineCount());
+    import_logic.setFiles({writeFile("importpreview_other.txt", 5)});
+    preview.setFile(0);
+    EXPECT_EQ(0, preview.cachedLineCount());
+    EXPECT_EQ(6, preview.lineCount());
+}
+
+//! Test that the preview doesn't access files removed from the file list
+TEST_F(ImportPreviewTest, replacedFilesTest)
+{
+    ImportLogic import_logic;
+    import_logic.setFiles({writeFile("importpreview_replaced.txt", 20)});
+
+    ImportPreview preview(&import_logic);
+    preview.setFile(0);
+    EXPECT_EQ(21, preview.lineCount());
+    EXPECT_FALSE(preview.html(0, 5).empty());
+
+    import_logic.setFiles({});
+    EXPECT_EQ(0, preview.lineCount());
+    EXPECT_EQ("", preview.html(0, 5));
+    EXPECT_EQ("", preview.line(0));
+
+    // another file in the same row is shown only once it is set
+    import_logic.setFiles({writeFile("importpreview_replacement.txt", 5)});
+    EXPECT_EQ(0, preview.lineCount());
+    preview.setFile(0);
+    EXPECT_EQ(6, preview.lineCount());
+}
@@ -12,6 +12,9 @@
 #include <darefl/famousloader/importutils.h>
 
 #include <cmath>
+#include <cstdlib>
+#include <random>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -88,3 +91,44 @@ TEST_F(DataImportUtilsTest, transposeTest)
 
     EXPECT_EQ(compare, transposed);
 }
+
+//! Test the in place tokenizer
+TEST_F(DataImportUtilsTest, forEachTokenTest)
+{
+    std::vector<std::string_view> tokens;
+    forEachToken(",This,,is,a,,test,", ',', [&](std::string_view token) { tokens.push_back(token); });
+    std::vector<std::string_view> compare{"This", "is", "a", "test"};
+
+    EXPECT_EQ(compare, tokens);
+}
+
+//! Test the conversion to double against std::strtod
+TEST_F(DataImportUtilsTest, toDoubleTest)
+{
+    std::vector<std::string> inputs{"0",     "-0",       "1.",       ".5",        "-2.5e3",
+                                    "1e-5",  "+3.25E+2", "123456789", "0.1",      "1e22",
+                                    "1e23",  "1e-30",    " 4.5",     "4.5abc",    "nan",
+                                    "inf",   "0x10",     "12345678901234567890123", "1e1000"};
+    std::default_random_engine engine;
+    std::uniform_real_distribution<double> distribution(-1e8, 1e8);
+    for (int i = 0; i < 1000; ++i) {
+        std::ostringstream stream;
+        stream.precision(i % 18 + 1);
+        stream << distribution(engine) * std::pow(10.0, i % 40 - 20);
+        inputs.push_back(stream.str());
+    }
+
+    for (const auto& input : inputs) {
+        double expected = std::strtod(input.c_str(), nullptr);
+        if (input == "1e1000" || std::isnan(expected)) {
+            EXPECT_TRUE(std::isnan(toDouble(input)));
+        } else {
+            EXPECT_EQ(expected, toDouble(input)) << input;
+        }
+    }
+
+    EXPECT_TRUE(std::isnan(toDouble("")));
+    EXPECT_TRUE(std::isnan(toDouble("abc")));
+    EXPECT_TRUE(std::isnan(toDouble("-")));
+    EXPECT_TRUE(std::signbit(toDouble("-0.0")));
+}
@@ -0,0 +1,67 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include <QSignalSpy>
+#include <atomic>
+#include <chrono>
+#include <darefl/quicksimeditor/jobmanager.h>
+#include <thread>
+
+//! Tests of JobManager.
+
+class JobManagerTest : public ::testing::Test
+{
+public:
+    ~JobManagerTest();
+
+    //! Returns Si substrate.
+    static multislice_t createMultislice()
+    {
+        return {{{0.0, 0.0}, 0.0, 0.0}, {{2.0704e-06, 0.0}, 0.0, 0.0}};
+    }
+};
+
+JobManagerTest::~JobManagerTest() = default;
+
+//! Result of a simulation which finishes after a newer request was served from the cache is
+//! dropped.
+
+TEST_F(JobManagerTest, outdatedResultIsDropped)
+{
+    JobManager manager;
+    QSignalSpy spy_completed(&manager, &JobManager::simulationCompleted);
+    std::atomic<bool> is_finished{false};
+    QObject::connect(&manager, &JobManager::progressChanged, [&is_finished](int value) {
+        if (value == 100)
+            is_finished = true;
+    });
+
+    const std::vector<double> cached_qvalues = {0.1, 0.2, 0.3};
+    manager.requestSimulation(createMultislice(), cached_qvalues, 1.0);
+    ASSERT_TRUE(spy_completed.wait(10000));
+    const auto cached_result = manager.simulationResult();
+    ASSERT_EQ(cached_result.qvalues, cached_qvalues);
+
+    // long simulation is overtaken by the request served from the cache
+    is_finished = false;
+    std::vector<double> long_qvalues(200000, 0.2);
+    manager.requestSimulation(createMultislice(), long_qvalues, 1.0);
+    manager.requestSimulation(createMultislice(), cached_qvalues, 1.0);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!is_finished && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_TRUE(is_finished);
+    // giving the simulation thread time to publish its result, if it would
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    EXPECT_EQ(manager.simulationResult().qvalues, cached_qvalues);
+    EXPECT_TRUE(manager.simulationResult().qvalues.empty());
+}
@@ -0,0 +1,103 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include <cmath>
+#include <minikernel/Computation/Slice.h>
+#include <minikernel/Material/MaterialFactoryFuncs.h>
+#include <minikernel/MultiLayer/KzComputation.h>
+#include <minikernel/MultiLayer/LayerRoughness.h>
+#include <minikernel/Vector/Vectors3D.h>
+
+using BornAgain::Slice;
+
+//! Tests of bulk kz computations from KzComputation namespace.
+
+class KzComputationTest : public ::testing::Test
+{
+public:
+    ~KzComputationTest();
+
+    //! Returns ambience, Ti/Ni bilayer and Si substrate.
+    static std::vector<Slice> sldSlices()
+    {
+        std::vector<Slice> result;
+        result.emplace_back(0.0, MaterialBySLD("air", 0.0, 0.0));
+        result.emplace_back(3.0, MaterialBySLD("ti", -1.9493e-06, 0.0));
+        result.emplace_back(8.0, MaterialBySLD("ni", 9.4245e-06, 0.0));
+        result.emplace_back(0.0, MaterialBySLD("si", 2.0704e-06, 0.0));
+        return result;
+    }
+
+    //! Returns slices made of refractive materials (wavelength dependent).
+    static std::vector<Slice> refIndexSlices()
+    {
+        std::vector<Slice> result;
+        result.emplace_back(0.0, HomogeneousMaterial("air", 0.0, 0.0));
+        result.emplace_back(3.0, HomogeneousMaterial("ti", -7.36e-7, 3.0e-9));
+        result.emplace_back(8.0, HomogeneousMaterial("ni", 2.9e-6, 1.0e-8));
+        result.emplace_back(0.0, HomogeneousMaterial("si", 2.1e-6, 2.0e-9));
+        return result;
+    }
+};
+
+KzComputationTest::~KzComputationTest() = default;
+
+//! Bulk SLD computation gives the same result as point-by-point computation.
+
+TEST_F(KzComputationTest, bulkKzFromSLDs)
+{
+    auto slices = sldSlices();
+    const std::vector<double> kz_values = {-0.5, -0.01, -0.001, 0.0, 0.002};
+
+    auto kz_matrix = KzComputation::computeKzFromSLDs(slices, kz_values);
+    ASSERT_EQ(kz_matrix.size(), kz_values.size());
+
+    for (size_t j = 0; j < kz_values.size(); ++j) {
+        auto expected = KzComputation::computeKzFromSLDs(slices, kz_values[j]);
+        ASSERT_EQ(kz_matrix[j].size(), slices.size());
+        for (size_t i = 0; i < slices.size(); ++i) {
+            EXPECT_DOUBLE_EQ(kz_matrix[j][i].real(), expected[i].real());
+            EXPECT_DOUBLE_EQ(kz_matrix[j][i].imag(), expected[i].imag());
+        }
+    }
+}
+
+//! Time-of-flight scan at fixed angle and many wavelengths (some of them repeated) gives the same
+//! result as point-by-point computation.
+
+TEST_F(KzComputationTest, bulkKzFromRefIndices)
+{
+    auto slices = refIndexSlices();
+    const double alpha = 0.01;
+    const std::vector<double> wavelengths = {0.2, 0.4, 0.2, 0.6, 0.8, 0.4};
+    const std::vector<double> angles(wavelengths.size(), alpha);
+
+    auto kz_matrix = KzComputation::computeKzFromRefIndices(slices, angles, wavelengths);
+    ASSERT_EQ(kz_matrix.size(), wavelengths.size());
+
+    for (size_t j = 0; j < wavelengths.size(); ++j) {
+        const double k = 2 * M_PI / wavelengths[j];
+        const kvector_t k_vector(k * std::cos(alpha), 0.0, -k * std::sin(alpha));
+        auto expected = KzComputation::computeKzFromRefIndices(slices, k_vector);
+        ASSERT_EQ(kz_matrix[j].size(), slices.size());
+        for (size_t i = 0; i < slices.size(); ++i) {
+            EXPECT_NEAR(kz_matrix[j][i].real(), expected[i].real(), 1e-12);
+            EXPECT_NEAR(kz_matrix[j][i].imag(), expected[i].imag(), 1e-12);
+        }
+    }
+}
+
+//! Angles and wavelengths should come in pairs.
+
+TEST_F(KzComputationTest, bulkKzSizeMismatch)
+{
+    EXPECT_THROW(KzComputation::computeKzFromRefIndices(refIndexSlices(), {0.1, 0.2}, {0.1}),
+                 std::runtime_error);
+}
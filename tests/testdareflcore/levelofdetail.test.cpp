@@ -0,0 +1,104 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include <algorithm>
+#include <cmath>
+#include <darefl/model/levelofdetail.h>
+
+//! Tests of LevelOfDetail.
+
+class LevelOfDetailTest : public ::testing::Test
+{
+public:
+    ~LevelOfDetailTest();
+
+    //! Returns sine curve with a single spike.
+    static ExperimentalDataStore::columns_t createColumns(size_t size)
+    {
+        auto result = std::make_shared<ExperimentalDataStore::Columns>();
+        for (size_t i = 0; i < size; ++i) {
+            result->axis.push_back(0.001 * i);
+            result->values.push_back(std::sin(0.1 * i) * (i == 5003 ? 10.0 : 1.0));
+        }
+        return result;
+    }
+
+    static bool contains(const std::vector<size_t>& indices, size_t index)
+    {
+        return std::find(indices.begin(), indices.end(), index) != indices.end();
+    }
+};
+
+LevelOfDetailTest::~LevelOfDetailTest() = default;
+
+//! All points are kept if there are only a few of them in the range.
+
+TEST_F(LevelOfDetailTest, fewPoints)
+{
+    LevelOfDetail lod(createColumns(10));
+    std::vector<size_t> expected = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    EXPECT_EQ(lod.indices(0.0, 1.0, 100, false), expected);
+    EXPECT_TRUE(LevelOfDetail(createColumns(0)).indices(0.0, 1.0, 100, false).empty());
+}
+
+//! Decimated curve is sorted, bounded by the number of columns and keeps extremes.
+
+TEST_F(LevelOfDetailTest, envelope)
+{
+    const size_t size = 100000;
+    LevelOfDetail lod(createColumns(size));
+
+    const int n_columns = 200;
+    auto indices = lod.indices(-1.0, 1000.0, n_columns, false);
+    EXPECT_LE(indices.size(), 8u * n_columns + 8u);
+    EXPECT_TRUE(std::is_sorted(indices.begin(), indices.end()));
+    EXPECT_EQ(indices.front(), 0u);
+    EXPECT_EQ(indices.back(), size - 1);
+    EXPECT_TRUE(contains(indices, 5003));
+
+    // the same result is returned from the cache
+    EXPECT_EQ(lod.indices(-1.0, 1000.0, n_columns, false), indices);
+}
+
+//! Pan reuses the grid of columns, so the common part of the curve stays the same.
+
+TEST_F(LevelOfDetailTest, pan)
+{
+    LevelOfDetail lod(createColumns(100000));
+
+    auto indices = lod.indices(10.0, 20.0, 100, false);
+    auto shifted = lod.indices(15.0, 25.0, 100, false);
+
+    std::vector<size_t> common, common_shifted;
+    std::copy_if(indices.begin(), indices.end(), std::back_inserter(common),
+                 [](auto index) { return index >= 16000 && index < 20000; });
+    std::copy_if(shifted.begin(), shifted.end(), std::back_inserter(common_shifted),
+                 [](auto index) { return index >= 16000 && index < 20000; });
+    EXPECT_FALSE(common.empty());
+    EXPECT_EQ(common, common_shifted);
+}
+
+//! With log scale non-positive values are not taken as minimum.
+
+TEST_F(LevelOfDetailTest, logScale)
+{
+    auto columns = std::make_shared<ExperimentalDataStore::Columns>();
+    for (size_t i = 0; i < 1000; ++i) {
+        columns->axis.push_back(static_cast<double>(i));
+        columns->values.push_back(i == 500 ? -1.0 : (i == 501 ? 0.001 : 1.0));
+    }
+    LevelOfDetail lod(columns);
+
+    auto linear = lod.indices(0.0, 999.0, 10, false);
+    EXPECT_TRUE(contains(linear, 500));
+
+    auto log = lod.indices(0.0, 999.0, 10, true);
+    EXPECT_TRUE(contains(log, 501));
+}
@@ -0,0 +1,63 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include <darefl/model/layeritems.h>
+#include <darefl/model/materialitems.h>
+#include <darefl/model/materialmodel.h>
+#include <darefl/model/materialpropertycontroller.h>
+#include <darefl/model/samplemodel.h>
+#include <mvvm/model/externalproperty.h>
+#include <mvvm/model/modelutils.h>
+
+using namespace ModelView;
+
+//! Tests of MaterialPropertyController.
+
+class MaterialPropertyControllerTest : public ::testing::Test
+{
+public:
+    ~MaterialPropertyControllerTest();
+};
+
+MaterialPropertyControllerTest::~MaterialPropertyControllerTest() = default;
+
+//! Layers follow the changes of the linked material and are unlinked on material removal.
+
+TEST_F(MaterialPropertyControllerTest, linkedLayers)
+{
+    MaterialModel material_model;
+    SampleModel sample_model;
+    MaterialPropertyController controller(&material_model, &sample_model);
+
+    auto container = Utils::TopItem<MaterialContainerItem>(&material_model);
+    auto material0 = dynamic_cast<SLDMaterialItem*>(container->children().at(0));
+    auto material1 = dynamic_cast<SLDMaterialItem*>(container->children().at(1));
+
+    auto multilayer = sample_model.insertItem<MultiLayerItem>();
+    auto layer0 = sample_model.insertItem<LayerItem>(multilayer);
+    auto layer1 = sample_model.insertItem<LayerItem>(multilayer);
+    layer0->setProperty(LayerItem::P_MATERIAL, material0->external_property());
+    layer1->setProperty(LayerItem::P_MATERIAL, material1->external_property());
+
+    // renaming of the material changes only the linked layer
+    material0->setProperty(MaterialBaseItem::P_NAME, std::string("Gold"));
+    EXPECT_EQ(layer0->property<ExternalProperty>(LayerItem::P_MATERIAL),
+              material0->external_property());
+    EXPECT_EQ(layer0->property<ExternalProperty>(LayerItem::P_MATERIAL).text(), "Gold");
+    EXPECT_EQ(layer1->property<ExternalProperty>(LayerItem::P_MATERIAL),
+              material1->external_property());
+
+    // removal of the material unlinks the layer
+    material_model.removeItem(container, material0->tagRow());
+    EXPECT_EQ(layer0->property<ExternalProperty>(LayerItem::P_MATERIAL),
+              ExternalProperty::undefined());
+    EXPECT_EQ(layer1->property<ExternalProperty>(LayerItem::P_MATERIAL),
+              material1->external_property());
+}
@@ -0,0 +1,118 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include <darefl/quicksimeditor/simulationresultcache.h>
+
+//! Tests of SimulationResultCache.
+
+class SimulationResultCacheTest : public ::testing::Test
+{
+public:
+    ~SimulationResultCacheTest();
+
+    using input_t = SimulationResultCache::input_t;
+    using result_t = SimulationResultCache::result_t;
+
+    static input_t createInput(double thickness)
+    {
+        input_t result;
+        result.slice_data = {{{0.0, 0.0}, 0.0, 0.0}, {{1e-06, 0.0}, thickness, 1.0}};
+        result.qvalues = {0.1, 0.2, 0.3};
+        result.intensity = 1.0;
+        return result;
+    }
+
+    static result_t createResult(double value)
+    {
+        return {{0.1, 0.2, 0.3}, {value, value, value}};
+    }
+};
+
+SimulationResultCacheTest::~SimulationResultCacheTest() = default;
+
+TEST_F(SimulationResultCacheTest, initialState)
+{
+    SimulationResultCache cache(1024);
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(cache.memoryUsage(), 0);
+    EXPECT_EQ(cache.memoryBudget(), 1024);
+    EXPECT_FALSE(cache.find(createInput(10.0)).has_value());
+}
+
+TEST_F(SimulationResultCacheTest, hash)
+{
+    EXPECT_EQ(SimulationResultCache::hash(createInput(10.0)),
+              SimulationResultCache::hash(createInput(10.0)));
+    EXPECT_NE(SimulationResultCache::hash(createInput(10.0)),
+              SimulationResultCache::hash(createInput(11.0)));
+
+    auto input = createInput(10.0);
+    input.intensity = 2.0;
+    EXPECT_NE(SimulationResultCache::hash(createInput(10.0)), SimulationResultCache::hash(input));
+}
+
+TEST_F(SimulationResultCacheTest, insertAndFind)
+{
+    SimulationResultCache cache(1024 * 1024);
+    cache.insert(createInput(10.0), createResult(1.0));
+    cache.insert(createInput(20.0), createResult(2.0));
+    EXPECT_EQ(cache.size(), 2);
+
+    auto result = cache.find(createInput(10.0));
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->amplitudes, createResult(1.0).amplitudes);
+
+    result = cache.find(createInput(20.0));
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->amplitudes, createResult(2.0).amplitudes);
+
+    EXPECT_FALSE(cache.find(createInput(30.0)).has_value());
+
+    // inserting same input replaces the result
+    cache.insert(createInput(10.0), createResult(3.0));
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.find(createInput(10.0))->amplitudes, createResult(3.0).amplitudes);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(cache.memoryUsage(), 0);
+}
+
+//! Least recently used entries are removed when memory budget is exceeded.
+
+TEST_F(SimulationResultCacheTest, memoryBudget)
+{
+    SimulationResultCache cache(1024 * 1024);
+    cache.insert(createInput(10.0), createResult(1.0));
+    const size_t entry_size = cache.memoryUsage();
+
+    // budget for two entries
+    cache.setMemoryBudget(2 * entry_size);
+    cache.insert(createInput(20.0), createResult(2.0));
+    EXPECT_EQ(cache.size(), 2);
+
+    // accessing first entry makes the second one the least recently used
+    EXPECT_TRUE(cache.find(createInput(10.0)).has_value());
+    cache.insert(createInput(30.0), createResult(3.0));
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_TRUE(cache.find(createInput(10.0)).has_value());
+    EXPECT_FALSE(cache.find(createInput(20.0)).has_value());
+    EXPECT_TRUE(cache.find(createInput(30.0)).has_value());
+
+    // shrinking the budget
+    cache.setMemoryBudget(entry_size);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_TRUE(cache.find(createInput(30.0)).has_value());
+
+    // entry which is larger than the whole budget is not stored
+    cache.setMemoryBudget(0);
+    cache.insert(createInput(40.0), createResult(4.0));
+    EXPECT_EQ(cache.size(), 0);
+}
@@ -0,0 +1,94 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include <minikernel/Computation/Slice.h>
+#include <minikernel/Material/MaterialFactoryFuncs.h>
+#include <minikernel/MultiLayer/KzComputation.h>
+#include <minikernel/MultiLayer/LayerRoughness.h>
+#include <minikernel/MultiLayer/SpecularScalarTanhStrategy.h>
+
+using BornAgain::Slice;
+
+//! Tests of lightweight entry points of SpecularScalarStrategy.
+
+class SpecularScalarStrategyTest : public ::testing::Test
+{
+public:
+    ~SpecularScalarStrategyTest();
+
+    //! Returns ambience, repeated Ti/Ni bilayer and Si substrate.
+    static std::vector<Slice> createSlices()
+    {
+        const LayerRoughness roughness(1.0, 0.0, 0.0);
+        std::vector<Slice> result;
+        result.emplace_back(0.0, MaterialBySLD("air", 0.0, 0.0));
+        for (int i = 0; i < 10; ++i) {
+            result.emplace_back(3.0, MaterialBySLD("ti", -1.9493e-06, 0.0), roughness);
+            result.emplace_back(7.0, MaterialBySLD("ni", 9.4245e-06, 1e-08), roughness);
+        }
+        result.emplace_back(0.0, MaterialBySLD("si", 2.0704e-06, 0.0), roughness);
+        return result;
+    }
+};
+
+SpecularScalarStrategyTest::~SpecularScalarStrategyTest() = default;
+
+//! Top layer reflection amplitude coincides with the one from full computation.
+
+TEST_F(SpecularScalarStrategyTest, topLayerR)
+{
+    SpecularScalarTanhStrategy strategy;
+    auto slices = createSlices();
+
+    for (double q : {0.0, 0.001, 0.01, 0.05, 0.1, 0.5, 1.0}) {
+        auto kz = KzComputation::computeKzFromSLDs(slices, -0.5 * q);
+        auto expected = strategy.Execute(slices, kz).front()->getScalarR();
+        auto r = strategy.topLayerR(slices, kz);
+        EXPECT_NEAR(r.real(), expected.real(), 1e-12);
+        EXPECT_NEAR(r.imag(), expected.imag(), 1e-12);
+    }
+}
+
+//! Single interface without roughness gives Fresnel reflection coefficient.
+
+TEST_F(SpecularScalarStrategyTest, fresnelCoefficient)
+{
+    SpecularScalarTanhStrategy strategy;
+    std::vector<Slice> slices;
+    slices.emplace_back(0.0, MaterialBySLD("air", 0.0, 0.0));
+    slices.emplace_back(0.0, MaterialBySLD("si", 2.0704e-06, 0.0));
+
+    auto kz = KzComputation::computeKzFromSLDs(slices, -0.5 * 0.05);
+    auto expected = (kz[0] - kz[1]) / (kz[0] + kz[1]);
+    auto r = strategy.topLayerR(slices, kz);
+    EXPECT_NEAR(r.real(), expected.real(), 1e-12);
+    EXPECT_NEAR(r.imag(), expected.imag(), 1e-12);
+}
+
+//! Amplitudes written into caller-provided buffer coincide with coefficients from full
+//! computation.
+
+TEST_F(SpecularScalarStrategyTest, computeAmplitudes)
+{
+    SpecularScalarTanhStrategy strategy;
+    auto slices = createSlices();
+
+    std::vector<Eigen::Vector2cd> t_r;
+    for (double q : {0.0, 0.01, 0.1}) {
+        auto kz = KzComputation::computeKzFromSLDs(slices, -0.5 * q);
+        auto coeffs = strategy.Execute(slices, kz);
+        strategy.computeAmplitudes(slices, kz, t_r);
+        ASSERT_EQ(t_r.size(), coeffs.size());
+        for (size_t i = 0; i < coeffs.size(); ++i) {
+            EXPECT_EQ(t_r[i](0), coeffs[i]->getScalarT());
+            EXPECT_EQ(t_r[i](1), coeffs[i]->getScalarR());
+        }
+    }
+}
@@ -0,0 +1,64 @@
+// ************************************************************************** //
+//
+//  Reflectometry simulation software prototype
+//
+//! @license   GNU General Public License v3 or higher (see COPYING)
+//! @authors   see AUTHORS
+//
+// ************************************************************************** //
+
+#include "google_test.h"
+#include <darefl/quicksimeditor/speculartoysimulation.h>
+#include <stdexcept>
+
+//! Tests of SpecularToySimulation.
+
+class SpecularToySimulationTest : public ::testing::Test
+{
+public:
+    ~SpecularToySimulationTest();
+
+    //! Returns input data for the Si substrate.
+    static SpecularToySimulation::InputData createInputData(std::vector<double> qvalues)
+    {
+        SpecularToySimulation::InputData result;
+        result.qvalues = std::move(qvalues);
+        result.slice_data = {{{0.0, 0.0}, 0.0, 0.0}, {{2.0704e-06, 0.0}, 0.0, 0.0}};
+        result.intensity = 1.0;
+        return result;
+    }
+
+    static std::vector<double> simulate(const SpecularToySimulation::InputData& input_data)
+    {
+        SpecularToySimulation simulation(input_data);
+        simulation.runSimulation();
+        return simulation.simulationResult().amplitudes;
+    }
+};
+
+SpecularToySimulationTest::~SpecularToySimulationTest() = default;
+
+//! Resolution smearing averages the reflectivity over neighbouring q-values.
+
+TEST_F(SpecularToySimulationTest, resolutionSmearing)
+{
+    auto input_data = createInputData({0.01, 0.3, 0.6});
+    auto expected = simulate(input_data);
+    ASSERT_EQ(expected.size(), 3u);
+
+    input_data.qresolution = {0.0, 0.0, 0.0};
+    auto result = simulate(input_data);
+    ASSERT_EQ(result.size(), 3u);
+    for (size_t i = 0; i < result.size(); ++i)
+        EXPECT_NEAR(result[i], expected[i], 1e-12 * expected[i]);
+
+    // total reflection isn't affected, convex tail of the curve is lifted
+    input_data.qresolution = {1e-3, 0.03, 0.06};
+    result = simulate(input_data);
+    EXPECT_NEAR(result[0], expected[0], 1e-6);
+    EXPECT_GT(result[1], expected[1]);
+    EXPECT_GT(result[2], expected[2]);
+
+    input_data.qresolution = {1e-3};
+    EXPECT_THROW(SpecularToySimulation{input_data}, std::runtime_error);
+}